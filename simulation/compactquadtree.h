@@ -0,0 +1,160 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "quadtreeconcept.h"
+#include "shapeprimitives.h"
+
+// A Branch is always split into four equal quadrants, so a Branch's Rectangle is implied by its parent's and
+// its position among its siblings and is recomputed while walking down from the root rather than stored.
+// Branches are stored breadth first, so the four children of a Branch are contiguous, and a Branch's Leaves
+// run from its m_FirstLeaf up to the next Branch's m_FirstLeaf. A sentinel Branch closes the last range.
+struct CompactQuadtreeBranch
+{
+    // Index of the Top Left child, the other three follow it. 0 when the Branch has no children, as the root
+    // is never a child.
+    uint32_t m_FirstBranch{0};
+    uint32_t m_FirstLeaf{0};
+
+    bool HasBranches() const { return m_FirstBranch != 0; }
+};
+
+static_assert(sizeof(CompactQuadtreeBranch) <= 16);
+static_assert(std::is_trivially_copyable_v<CompactQuadtreeBranch>);
+
+// Read only compact copy of a built Quadtree for large worlds where the Quadtree's memory footprint, rather
+// than the work per Branch, limits queries. Leaves are 32 bit indices into the Leaves the Quadtree was built
+// from, found Leaves point into them, so they must stay alive and in place for as long as the CompactQuadtree
+// is queried.
+template<class TQuadtree>
+class CompactQuadtreeConcept
+{
+public:
+    using Quadtree = TQuadtree;
+    using Leaf = typename TQuadtree::Leaf;
+    using Branch = typename TQuadtree::Branch;
+
+    void Build(const Quadtree& quadtree, std::span<Leaf> leaves);
+    template<class TAllocator>
+    bool FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+    std::span<const CompactQuadtreeBranch> GetBranches() const { return {m_Branches.data(), GetNumBranches()}; }
+    size_t GetNumBranches() const { return m_Branches.empty() ? 0 : m_Branches.size() - 1; }
+    // Bytes owned by the CompactQuadtree, including itself.
+    size_t GetMemoryUsage() const;
+private:
+    template<class TAllocator>
+    void FindLeaves(uint32_t branchIndex, const Rectangle& branchRect, const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+
+    std::vector<CompactQuadtreeBranch> m_Branches{};
+    std::vector<uint32_t> m_Leaves{};
+    Rectangle m_Rect{};
+    Leaf* m_LeafData{nullptr};
+};
+
+// Bytes owned by a Quadtree's Branches, including the Quadtree itself. Allocator overhead is not included.
+template<class TQuadtree>
+size_t QuadtreeMemoryUsageConcept(const TQuadtree& quadtree)
+{
+    using Branch = typename TQuadtree::Branch;
+
+    size_t memoryUsage{sizeof(TQuadtree)};
+    std::vector<const Branch*> branches{&quadtree.GetRootBranch()};
+    while(!branches.empty())
+    {
+        const Branch& branch{*branches.back()};
+        branches.pop_back();
+
+        memoryUsage += branch.GetBranches().capacity() * sizeof(Branch);
+        memoryUsage += branch.GetLeaves().capacity() * sizeof(typename TQuadtree::Leaf*);
+
+        for(const Branch& childBranch : branch.GetBranches())
+        {
+            branches.push_back(&childBranch);
+        }
+    }
+    return memoryUsage;
+}
+
+template<class TQuadtree>
+void CompactQuadtreeConcept<TQuadtree>::Build(const Quadtree& quadtree, const std::span<Leaf> leaves)
+{
+    m_Branches.clear();
+    m_Leaves.clear();
+    m_Leaves.reserve(leaves.size());
+    m_Rect = quadtree.GetRootBranch().GetRect();
+    m_LeafData = leaves.data();
+
+    std::vector<const Branch*> branches{&quadtree.GetRootBranch()};
+    for(size_t i{0}; i != branches.size(); ++i)
+    {
+        const Branch& branch{*branches[i]};
+        assert(!branch.HasBranches() || branch.GetBranches().size() == 4);
+
+        CompactQuadtreeBranch compactBranch{};
+        compactBranch.m_FirstBranch = branch.HasBranches() ? static_cast<uint32_t>(branches.size()) : 0;
+        compactBranch.m_FirstLeaf = static_cast<uint32_t>(m_Leaves.size());
+        m_Branches.push_back(compactBranch);
+
+        for(const Branch& childBranch : branch.GetBranches())
+        {
+            branches.push_back(&childBranch);
+        }
+
+        for(const Leaf* const leaf : branch.GetLeaves())
+        {
+            assert(leaf >= leaves.data() && leaf < leaves.data() + leaves.size());
+            m_Leaves.push_back(static_cast<uint32_t>(leaf - leaves.data()));
+        }
+    }
+
+    m_Branches.push_back(CompactQuadtreeBranch{0, static_cast<uint32_t>(m_Leaves.size())});
+    m_Branches.shrink_to_fit();
+}
+
+template<class TQuadtree>
+template<class TAllocator>
+bool CompactQuadtreeConcept<TQuadtree>::FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const
+{
+    assert(foundLeaves.empty());
+    if(!m_Branches.empty())
+    {
+        FindLeaves(0, m_Rect, rect, foundLeaves);
+    }
+    return !foundLeaves.empty();
+}
+
+template<class TQuadtree>
+size_t CompactQuadtreeConcept<TQuadtree>::GetMemoryUsage() const
+{
+    return sizeof(*this) + m_Branches.capacity() * sizeof(CompactQuadtreeBranch) + m_Leaves.capacity() * sizeof(uint32_t);
+}
+
+template<class TQuadtree>
+template<class TAllocator>
+void CompactQuadtreeConcept<TQuadtree>::FindLeaves(
+    const uint32_t branchIndex, const Rectangle& branchRect, const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const
+{
+    if(!CollisionRectRect(rect, branchRect))
+        return;
+
+    const CompactQuadtreeBranch& branch{m_Branches[branchIndex]};
+    if(!branch.HasBranches())
+    {
+        for(uint32_t i{branch.m_FirstLeaf}; i != m_Branches[branchIndex + 1].m_FirstLeaf; ++i)
+        {
+            foundLeaves.push_back(m_LeafData + m_Leaves[i]);
+        }
+        return;
+    }
+
+    // Same split as QuadtreeConcept::Branch::AddLeaf, Top Left, Top Right, Bottom Left, Bottom Right.
+    const float_t width{branchRect.GetWidth() * 0.5f};
+    const float_t height{branchRect.GetHeight() * 0.5f};
+    const glm::vec2& topLeft{branchRect.GetTopLeft()};
+    FindLeaves(branch.m_FirstBranch, Rectangle{topLeft, width, height}, rect, foundLeaves);
+    FindLeaves(branch.m_FirstBranch + 1, Rectangle{topLeft + glm::vec2{width, 0.0f}, width, height}, rect, foundLeaves);
+    FindLeaves(branch.m_FirstBranch + 2, Rectangle{topLeft + glm::vec2{0.0f, height}, width, height}, rect, foundLeaves);
+    FindLeaves(branch.m_FirstBranch + 3, Rectangle{topLeft + glm::vec2{width, height}, width, height}, rect, foundLeaves);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <future>
+#include <vector>
+
+#include "quadtreeconcept.h"
+
+// Holds two Quadtrees, each built from its own snapshot of the Leaves. The front Quadtree is never written to
+// and can be queried while the back Quadtree is rebuilt on a background thread. Swap at a frame boundary to
+// make the most recently built Quadtree the front.
+// Any reads of the front Quadtree must have finished before the next call to BeginRebuild after a Swap.
+template<class TQuadtree>
+class DoubleBufferedQuadtreeConcept
+{
+public:
+    using Quadtree = TQuadtree;
+    using Leaf = typename TQuadtree::Leaf;
+
+    DoubleBufferedQuadtreeConcept() = default;
+    DoubleBufferedQuadtreeConcept(const DoubleBufferedQuadtreeConcept&) = delete;
+    DoubleBufferedQuadtreeConcept& operator=(const DoubleBufferedQuadtreeConcept&) = delete;
+    ~DoubleBufferedQuadtreeConcept();
+
+    void BeginRebuild(const std::vector<Leaf>& leaves);
+    bool IsRebuilding() const { return m_Rebuild.valid(); }
+    bool Swap();
+    const Quadtree& GetQuadtree() const { return m_Buffers[m_FrontIndex].m_Quadtree; }
+    const std::vector<Leaf>& GetLeaves() const { return m_Buffers[m_FrontIndex].m_Leaves; }
+private:
+    struct Buffer
+    {
+        Quadtree m_Quadtree{};
+        std::vector<Leaf> m_Leaves{};
+    };
+
+    Buffer& GetBackBuffer() { return m_Buffers[m_FrontIndex ^ 1]; }
+
+    std::array<Buffer, 2> m_Buffers{};
+    std::future<void> m_Rebuild{};
+    uint32_t m_FrontIndex{0};
+};
+
+template<class TQuadtree>
+DoubleBufferedQuadtreeConcept<TQuadtree>::~DoubleBufferedQuadtreeConcept()
+{
+    if(m_Rebuild.valid())
+    {
+        m_Rebuild.wait();
+    }
+}
+
+template<class TQuadtree>
+void DoubleBufferedQuadtreeConcept<TQuadtree>::BeginRebuild(const std::vector<Leaf>& leaves)
+{
+    assert(!m_Rebuild.valid());
+
+    // Snapshot the Leaves on the calling thread so the caller is free to modify them once this returns.
+    Buffer& backBuffer{GetBackBuffer()};
+    backBuffer.m_Leaves.assign(std::begin(leaves), std::end(leaves));
+
+    m_Rebuild = std::async(std::launch::async, [&backBuffer]()
+    {
+        RebuildQuadtreeConcept(backBuffer.m_Quadtree, backBuffer.m_Leaves);
+    });
+}
+
+template<class TQuadtree>
+bool DoubleBufferedQuadtreeConcept<TQuadtree>::Swap()
+{
+    if(!m_Rebuild.valid())
+    {
+        return false;
+    }
+
+    m_Rebuild.get();
+    m_FrontIndex ^= 1;
+    return true;
+}
@@ -0,0 +1,133 @@
+#include "stdafx.h"
+#include "flatquadtree.h"
+
+#include <fstream>
+
+bool FlatQuadtree::Load(const std::span<const std::byte> data)
+{
+    m_Branches = {};
+    m_Leaves = {};
+    m_NumSourceLeaves = 0;
+
+    // Everything in the layout is 4 byte aligned, the in place reads below are only valid from aligned data.
+    if(data.size() < sizeof(FlatQuadtreeHeader) || reinterpret_cast<uintptr_t>(data.data()) % alignof(FlatQuadtreeBranch) != 0)
+    {
+        return false;
+    }
+
+    const FlatQuadtreeHeader& header{*reinterpret_cast<const FlatQuadtreeHeader*>(data.data())};
+    if(header.m_Magic != FLAT_QUADTREE_MAGIC || header.m_Version != FLAT_QUADTREE_VERSION || header.m_NumBranches == 0)
+    {
+        return false;
+    }
+
+    const size_t branchesSize{header.m_NumBranches * sizeof(FlatQuadtreeBranch)};
+    const size_t leavesSize{header.m_NumLeaves * sizeof(uint32_t)};
+    if(data.size() != sizeof(FlatQuadtreeHeader) + branchesSize + leavesSize)
+    {
+        return false;
+    }
+
+    const std::span<const FlatQuadtreeBranch> branches{
+        reinterpret_cast<const FlatQuadtreeBranch*>(data.data() + sizeof(FlatQuadtreeHeader)), header.m_NumBranches};
+
+    const std::span<const uint32_t> leaves{
+        reinterpret_cast<const uint32_t*>(data.data() + sizeof(FlatQuadtreeHeader) + branchesSize), header.m_NumLeaves};
+
+    // Queries trust the layout, so require exactly the one SerialiseQuadtreeConcept writes. Walking the Branches
+    // breadth first, each Branch's children must be the next unclaimed Branches and its Leaves the next unclaimed
+    // Leaves. Every Branch is then the child of exactly one earlier Branch, so the Branches form a tree and
+    // every range is in bounds.
+    uint64_t nextBranch{1};
+    uint64_t nextLeaf{0};
+    for(size_t i{0}; i != branches.size(); ++i)
+    {
+        const FlatQuadtreeBranch& branch{branches[i]};
+        if(i >= nextBranch || branch.m_FirstBranch != nextBranch || branch.m_FirstLeaf != nextLeaf)
+        {
+            return false;
+        }
+
+        nextBranch += branch.m_NumBranches;
+        nextLeaf += branch.m_NumLeaves;
+    }
+
+    if(nextBranch != header.m_NumBranches || nextLeaf != header.m_NumLeaves)
+    {
+        return false;
+    }
+
+    // Leaf indices are handed to the caller to index the source vector.
+    for(const uint32_t leaf : leaves)
+    {
+        if(leaf >= header.m_NumSourceLeaves)
+        {
+            return false;
+        }
+    }
+
+    m_Branches = branches;
+    m_Leaves = leaves;
+    m_NumSourceLeaves = header.m_NumSourceLeaves;
+    return true;
+}
+
+bool FlatQuadtree::FindLeaves(const Rectangle& rect, std::vector<uint32_t>& foundLeaves) const
+{
+    assert(foundLeaves.empty());
+    if(!m_Branches.empty())
+    {
+        FindLeaves(m_Branches.front(), rect, foundLeaves);
+    }
+    return !foundLeaves.empty();
+}
+
+const FlatQuadtreeBranch* FlatQuadtree::FindBranch(const glm::vec2& point) const
+{
+    return m_Branches.empty() ? nullptr : FindBranch(m_Branches.front(), point);
+}
+
+void FlatQuadtree::FindLeaves(const FlatQuadtreeBranch& branch, const Rectangle& rect, std::vector<uint32_t>& foundLeaves) const
+{
+    if(!branch.HasBranches() && CollisionRectRect(rect, branch.m_Rect))
+    {
+        const std::span<const uint32_t> leaves{GetLeaves(branch)};
+        foundLeaves.insert(std::end(foundLeaves), std::begin(leaves), std::end(leaves));
+        return;
+    }
+
+    for(const FlatQuadtreeBranch& childBranch : m_Branches.subspan(branch.m_FirstBranch, branch.m_NumBranches))
+    {
+        FindLeaves(childBranch, rect, foundLeaves);
+    }
+}
+
+const FlatQuadtreeBranch* FlatQuadtree::FindBranch(const FlatQuadtreeBranch& branch, const glm::vec2& point) const
+{
+    if(CollisionRectPoint(branch.m_Rect, point))
+    {
+        for(const FlatQuadtreeBranch& childBranch : m_Branches.subspan(branch.m_FirstBranch, branch.m_NumBranches))
+        {
+            if(const FlatQuadtreeBranch* const foundBranch{FindBranch(childBranch, point)})
+            {
+                return foundBranch;
+            }
+        }
+
+        return &branch;
+    }
+
+    return nullptr;
+}
+
+bool SaveFlatQuadtree(const std::vector<std::byte>& data, const std::filesystem::path& path)
+{
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if(!file)
+    {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "quadtreeconcept.h"
+#include "shapeprimitives.h"
+
+// Pointer free layout of a built Quadtree. Branches are stored breadth first so a Branch's children are
+// contiguous, Leaves are stored as indices into the vector of Leaves the Quadtree was built from.
+// File layout: FlatQuadtreeHeader, FlatQuadtreeBranch[m_NumBranches], uint32_t[m_NumLeaves].
+inline constexpr uint32_t FLAT_QUADTREE_MAGIC{0x44415551}; // "QUAD"
+inline constexpr uint32_t FLAT_QUADTREE_VERSION{2};
+
+struct FlatQuadtreeHeader
+{
+    uint32_t m_Magic{FLAT_QUADTREE_MAGIC};
+    uint32_t m_Version{FLAT_QUADTREE_VERSION};
+    uint32_t m_NumBranches{0};
+    uint32_t m_NumLeaves{0};
+    // Size of the vector of Leaves the Quadtree was built from, every stored Leaf index is below it.
+    uint32_t m_NumSourceLeaves{0};
+};
+
+struct FlatQuadtreeBranch
+{
+    Rectangle m_Rect{};
+    uint32_t m_FirstBranch{0};
+    uint32_t m_NumBranches{0};
+    uint32_t m_FirstLeaf{0};
+    uint32_t m_NumLeaves{0};
+
+    bool HasBranches() const { return m_NumBranches != 0; }
+};
+
+static_assert(std::is_trivially_copyable_v<FlatQuadtreeHeader>);
+static_assert(std::is_trivially_copyable_v<FlatQuadtreeBranch>);
+
+// Queries a FlatQuadtree in place, the data it is loaded from (e.g. a MappedFile) must outlive it.
+// Load rejects data that is misaligned, or is not a tree laid out as SerialiseQuadtreeConcept writes it, so
+// queries on a loaded FlatQuadtree stay in bounds and visit each Branch at most once.
+class FlatQuadtree
+{
+public:
+    bool Load(std::span<const std::byte> data);
+    bool FindLeaves(const Rectangle& rect, std::vector<uint32_t>& foundLeaves) const;
+    const FlatQuadtreeBranch* FindBranch(const glm::vec2& point) const;
+    std::span<const FlatQuadtreeBranch> GetBranches() const { return m_Branches; }
+    std::span<const uint32_t> GetLeaves() const { return m_Leaves; }
+    std::span<const uint32_t> GetLeaves(const FlatQuadtreeBranch& branch) const { return m_Leaves.subspan(branch.m_FirstLeaf, branch.m_NumLeaves); }
+    uint32_t GetNumSourceLeaves() const { return m_NumSourceLeaves; }
+private:
+    void FindLeaves(const FlatQuadtreeBranch& branch, const Rectangle& rect, std::vector<uint32_t>& foundLeaves) const;
+    const FlatQuadtreeBranch* FindBranch(const FlatQuadtreeBranch& branch, const glm::vec2& point) const;
+
+    std::span<const FlatQuadtreeBranch> m_Branches{};
+    std::span<const uint32_t> m_Leaves{};
+    uint32_t m_NumSourceLeaves{0};
+};
+
+bool SaveFlatQuadtree(const std::vector<std::byte>& data, const std::filesystem::path& path);
+
+template<class TQuadtree>
+std::vector<std::byte> SerialiseQuadtreeConcept(const TQuadtree& quadtree, const std::vector<typename TQuadtree::Leaf>& leaves)
+{
+    using Branch = typename TQuadtree::Branch;
+
+    std::vector<FlatQuadtreeBranch> flatBranches{};
+    std::vector<uint32_t> flatLeaves{};
+    flatLeaves.reserve(leaves.size());
+
+    std::vector<const Branch*> branches{&quadtree.GetRootBranch()};
+    for(size_t i{0}; i != branches.size(); ++i)
+    {
+        const Branch& branch{*branches[i]};
+
+        FlatQuadtreeBranch flatBranch{};
+        flatBranch.m_Rect = branch.GetRect();
+        flatBranch.m_FirstBranch = static_cast<uint32_t>(branches.size());
+        flatBranch.m_NumBranches = static_cast<uint32_t>(branch.GetBranches().size());
+        flatBranch.m_FirstLeaf = static_cast<uint32_t>(flatLeaves.size());
+        flatBranch.m_NumLeaves = static_cast<uint32_t>(branch.GetLeaves().size());
+        flatBranches.push_back(flatBranch);
+
+        for(const Branch& childBranch : branch.GetBranches())
+        {
+            branches.push_back(&childBranch);
+        }
+
+        for(const typename TQuadtree::Leaf* const leaf : branch.GetLeaves())
+        {
+            assert(leaf >= leaves.data() && leaf < leaves.data() + leaves.size());
+            flatLeaves.push_back(static_cast<uint32_t>(leaf - leaves.data()));
+        }
+    }
+
+    FlatQuadtreeHeader header{};
+    header.m_NumBranches = static_cast<uint32_t>(flatBranches.size());
+    header.m_NumLeaves = static_cast<uint32_t>(flatLeaves.size());
+    header.m_NumSourceLeaves = static_cast<uint32_t>(leaves.size());
+
+    const size_t branchesSize{flatBranches.size() * sizeof(FlatQuadtreeBranch)};
+    const size_t leavesSize{flatLeaves.size() * sizeof(uint32_t)};
+    std::vector<std::byte> data(sizeof(FlatQuadtreeHeader) + branchesSize + leavesSize);
+    std::memcpy(data.data(), &header, sizeof(FlatQuadtreeHeader));
+    std::memcpy(data.data() + sizeof(FlatQuadtreeHeader), flatBranches.data(), branchesSize);
+    std::memcpy(data.data() + sizeof(FlatQuadtreeHeader) + branchesSize, flatLeaves.data(), leavesSize);
+    return data;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <concepts>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "quadtreeconcept.h"
+#include "shapeprimitives.h"
+
+// Two tier Quadtree for worlds where most Leaves never move. Static Leaves are built into their own Quadtree
+// once, reordered along the Z-order curve, and kept until RebuildStatic is called again. Only the dynamic
+// Leaves are rebuilt each frame, so the per frame rebuild cost scales with the number of moving Leaves.
+// Both tiers hold pointers into the vectors they were built from, which must not be resized while in use.
+// The static Quadtree always uses the default memory resource as it outlives any per frame arena.
+template<class TQuadtree>
+class LayeredQuadtreeConcept
+{
+public:
+    using Quadtree = TQuadtree;
+    using Leaf = typename TQuadtree::Leaf;
+    using Branch = typename TQuadtree::Branch;
+
+    LayeredQuadtreeConcept() = default;
+    explicit LayeredQuadtreeConcept(std::pmr::memory_resource* dynamicResource);
+
+    // Returns the new index of each static Leaf indexed by its old index, see ReorderLeavesConcept.
+    std::vector<uint32_t> RebuildStatic(std::vector<Leaf>& staticLeaves);
+    void RebuildDynamic(std::vector<Leaf>& dynamicLeaves);
+    // Queries span both tiers, static results come first.
+    template<class TAllocator>
+    bool FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+    template<class TAllocator>
+    bool FindBranches(const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const;
+    // Calls dynamicVisitor(leaf, otherLeaf) once for each pair of dynamic Leaves and staticVisitor(leaf, staticLeaf)
+    // for each dynamic Leaf and static Leaf whose centre is inside getBounds(leaf). Static Leaves are never paired
+    // with each other. getBounds must be large enough for both Leaves of a dynamic pair to find each other.
+    template<class TBounds, class TDynamicVisitor, class TStaticVisitor>
+        requires std::invocable<TDynamicVisitor&, typename TQuadtree::Leaf&, typename TQuadtree::Leaf&>
+            && std::invocable<TStaticVisitor&, typename TQuadtree::Leaf&, const typename TQuadtree::Leaf&>
+    void VisitPairs(TBounds&& getBounds, TDynamicVisitor&& dynamicVisitor, TStaticVisitor&& staticVisitor) const;
+    const Quadtree& GetStaticQuadtree() const { return m_StaticQuadtree; }
+    const Quadtree& GetDynamicQuadtree() const { return m_DynamicQuadtree; }
+private:
+    Quadtree m_StaticQuadtree{};
+    Quadtree m_DynamicQuadtree{};
+};
+
+template<class TQuadtree>
+LayeredQuadtreeConcept<TQuadtree>::LayeredQuadtreeConcept(std::pmr::memory_resource* const dynamicResource)
+    : m_DynamicQuadtree{dynamicResource}
+{
+}
+
+template<class TQuadtree>
+std::vector<uint32_t> LayeredQuadtreeConcept<TQuadtree>::RebuildStatic(std::vector<Leaf>& staticLeaves)
+{
+    // Built once, so it is worth reordering for locality of every later query.
+    return ReorderLeavesConcept(m_StaticQuadtree, staticLeaves);
+}
+
+template<class TQuadtree>
+void LayeredQuadtreeConcept<TQuadtree>::RebuildDynamic(std::vector<Leaf>& dynamicLeaves)
+{
+    RebuildQuadtreeConcept(m_DynamicQuadtree, dynamicLeaves);
+}
+
+template<class TQuadtree>
+template<class TAllocator>
+bool LayeredQuadtreeConcept<TQuadtree>::FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const
+{
+    assert(foundLeaves.empty());
+    m_StaticQuadtree.GetRootBranch().FindLeaves(rect, foundLeaves);
+    m_DynamicQuadtree.GetRootBranch().FindLeaves(rect, foundLeaves);
+    return !foundLeaves.empty();
+}
+
+template<class TQuadtree>
+template<class TAllocator>
+bool LayeredQuadtreeConcept<TQuadtree>::FindBranches(const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const
+{
+    assert(foundBranches.empty());
+    m_StaticQuadtree.GetRootBranch().FindBranches(rect, foundBranches);
+    m_DynamicQuadtree.GetRootBranch().FindBranches(rect, foundBranches);
+    return !foundBranches.empty();
+}
+
+template<class TQuadtree>
+template<class TBounds, class TDynamicVisitor, class TStaticVisitor>
+    requires std::invocable<TDynamicVisitor&, typename TQuadtree::Leaf&, typename TQuadtree::Leaf&>
+        && std::invocable<TStaticVisitor&, typename TQuadtree::Leaf&, const typename TQuadtree::Leaf&>
+void LayeredQuadtreeConcept<TQuadtree>::VisitPairs(TBounds&& getBounds, TDynamicVisitor&& dynamicVisitor, TStaticVisitor&& staticVisitor) const
+{
+    std::pmr::vector<Leaf*> foundLeaves{m_DynamicQuadtree.GetMemoryResource()};
+    std::pmr::vector<const Branch*> branches{{&m_DynamicQuadtree.GetRootBranch()}, m_DynamicQuadtree.GetMemoryResource()};
+    while(!branches.empty())
+    {
+        const Branch& branch{*branches.back()};
+        branches.pop_back();
+
+        for(Leaf* const leaf : branch.GetLeaves())
+        {
+            const Rectangle bounds{getBounds(std::as_const(*leaf))};
+
+            foundLeaves.clear();
+            m_StaticQuadtree.GetRootBranch().FindLeaves(bounds, foundLeaves);
+            for(const Leaf* const staticLeaf : foundLeaves)
+            {
+                if(CollisionRectPoint(bounds, staticLeaf->GetPosition()))
+                {
+                    staticVisitor(*leaf, *staticLeaf);
+                }
+            }
+
+            // Each dynamic pair is found from both Leaves, only the one stored first reports it.
+            foundLeaves.clear();
+            m_DynamicQuadtree.GetRootBranch().FindLeaves(bounds, foundLeaves);
+            for(Leaf* const otherLeaf : foundLeaves)
+            {
+                if(leaf < otherLeaf && CollisionRectPoint(bounds, otherLeaf->GetPosition()))
+                {
+                    dynamicVisitor(*leaf, *otherLeaf);
+                }
+            }
+        }
+
+        for(const Branch& childBranch : branch.GetBranches())
+        {
+            branches.push_back(&childBranch);
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include "stdafx.h"
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+    const HANDLE file{CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const HANDLE mapping{CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+    if(!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* const data{MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+    if(!data)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_Data = static_cast<const std::byte*>(data);
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+    m_FileHandle = file;
+    m_MappingHandle = mapping;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if(m_Data)
+    {
+        UnmapViewOfFile(m_Data);
+        CloseHandle(m_MappingHandle);
+        CloseHandle(m_FileHandle);
+    }
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_FileHandle = nullptr;
+    m_MappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+    const int file{open(path.c_str(), O_RDONLY)};
+    if(file == -1)
+    {
+        return false;
+    }
+
+    struct stat fileStat{};
+    if(fstat(file, &fileStat) == -1 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* const data{mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0)};
+    // The mapping keeps its own reference to the file.
+    close(file);
+    if(data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_Data = static_cast<const std::byte*>(data);
+    m_Size = static_cast<size_t>(fileStat.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if(m_Data)
+    {
+        munmap(const_cast<std::byte*>(m_Data), m_Size);
+    }
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+#endif
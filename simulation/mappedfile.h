@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+// Read only memory mapping of a whole file. The mapped pages are shared between every process mapping the
+// same file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool IsOpen() const { return m_Data != nullptr; }
+    std::span<const std::byte> GetData() const { return {m_Data, m_Size}; }
+private:
+    const std::byte* m_Data{nullptr};
+    size_t m_Size{0};
+#ifdef _WIN32
+    void* m_FileHandle{nullptr};
+    void* m_MappingHandle{nullptr};
+#endif
+};
@@ -1,6 +1,12 @@
 #pragma once
 
+#include "compactquadtree.h"
+#include "doublebufferedquadtree.h"
+#include "flatquadtree.h"
+#include "layeredquadtree.h"
 #include "quadtreeconcept.h"
+#include "quadtreesubscriptions.h"
+#include "quadtreeview.h"
 #include "shapeprimitives.h"
 
 namespace
@@ -9,6 +15,52 @@ namespace
     inline constexpr uint32_t CHILD_DEPTH_THRESHOLD{3};
 }
 
+struct CircleMassAggregate
+{
+    void AddLeaf(const Circle& circle)
+    {
+        AddMass(circle.m_Position, circle.m_Mass, 1);
+    }
+
+    void AddAggregate(const CircleMassAggregate& aggregate)
+    {
+        AddMass(aggregate.m_CentreOfMass, aggregate.m_Mass, aggregate.m_Count);
+    }
+
+    void AddMass(const glm::vec2& position, const float_t mass, const uint32_t count)
+    {
+        if(mass <= 0.0f)
+            return;
+
+        const float_t totalMass{m_Mass + mass};
+        m_CentreOfMass = (m_CentreOfMass * m_Mass + position * mass) / totalMass;
+        m_Mass = totalMass;
+        m_Count += count;
+    }
+
+    const glm::vec2& GetPosition() const { return m_CentreOfMass; }
+
+    glm::vec2 m_CentreOfMass{};
+    float_t m_Mass{0.0f};
+    uint32_t m_Count{0};
+};
+
 using Quadtree = QuadtreeConcept<Circle, SPLIT_THRESHOLD, CHILD_DEPTH_THRESHOLD>;
+using MassQuadtree = QuadtreeConcept<Circle, SPLIT_THRESHOLD, CHILD_DEPTH_THRESHOLD, CircleMassAggregate>;
 
 inline constexpr auto RebuildQuadtree = RebuildQuadtreeConcept<Quadtree>;
+inline constexpr auto RebuildMassQuadtree = RebuildQuadtreeConcept<MassQuadtree>;
+inline constexpr auto ReorderLeaves = ReorderLeavesConcept<Quadtree>;
+
+using CompactQuadtree = CompactQuadtreeConcept<Quadtree>;
+inline constexpr auto QuadtreeMemoryUsage = QuadtreeMemoryUsageConcept<Quadtree>;
+
+using DoubleBufferedQuadtree = DoubleBufferedQuadtreeConcept<Quadtree>;
+
+using LayeredQuadtree = LayeredQuadtreeConcept<Quadtree>;
+
+using QuadtreeView = QuadtreeViewConcept<Quadtree>;
+
+using QuadtreeSubscriptions = QuadtreeSubscriptionsConcept<Quadtree>;
+
+inline constexpr auto SerialiseQuadtree = SerialiseQuadtreeConcept<Quadtree>;
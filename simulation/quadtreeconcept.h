@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 #include "shapeprimitives.h"
@@ -11,42 +16,106 @@ concept LeafHasGetPositionVec2D =
         { leaf.GetPosition() } -> std::same_as<const glm::vec2&>;
     };
 
-template<class TLeaf, uint32_t SplitThreshold = 4, uint32_t ChildDepthThreshold = 2> requires LeafHasGetPositionVec2D<TLeaf>
+// Per Branch data reduced from the Branch's Leaves and child Branches, e.g. total mass and centre of mass.
+template <typename TAggregate, typename TLeaf>
+concept AggregateReducesLeaves =
+    std::default_initializable<TAggregate> &&
+    requires(TAggregate aggregate, const TLeaf& leaf, const TAggregate& childAggregate)
+    {
+        aggregate.AddLeaf(leaf);
+        aggregate.AddAggregate(childAggregate);
+    };
+
+struct NoAggregate
+{
+    template<class TLeaf>
+    void AddLeaf(const TLeaf&) {}
+    void AddAggregate(const NoAggregate&) {}
+};
+
+// Const member functions never modify the Quadtree, concurrent const queries are safe while it is not being
+// rebuilt. See QuadtreeViewConcept for a read only query API.
+// All Branches and their Leaf lists are allocated from the memory resource given on construction. Reset the
+// Quadtree before releasing the memory resource, e.g. a per frame std::pmr::monotonic_buffer_resource.
+// Query results are appended to vectors with any allocator, e.g. std::pmr::vector backed by the same arena.
+template<class TLeaf, uint32_t SplitThreshold = 4, uint32_t ChildDepthThreshold = 2, class TAggregate = NoAggregate>
+    requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
 class QuadtreeConcept
 {
 public:
     using Leaf = TLeaf;
+    using Aggregate = TAggregate;
 
     class Branch
     {
     public:
         Branch() = default;
-        explicit Branch(uint32_t depth, Rectangle&& rect, Branch* parent);
+        explicit Branch(std::pmr::memory_resource* resource);
+        explicit Branch(uint32_t depth, Rectangle&& rect, Branch* parent, std::pmr::memory_resource* resource);
         void AddLeaf(Leaf* newLeaf);
         void Reset();
         static Branch* FindBranch(Branch& branch, const glm::vec2& point);
-        void FindBranches(const Rectangle& rect, std::vector<Branch*>& foundBranches);
-        void FindLeaves(const Rectangle& rect, std::vector<Leaf*>& foundLeaves) const;
+        static const Branch* FindBranch(const Branch& branch, const glm::vec2& point);
+        template<class TAllocator>
+        void FindBranches(const Rectangle& rect, std::vector<Branch*, TAllocator>& foundBranches);
+        template<class TAllocator>
+        void FindBranches(const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const;
+        template<class TAllocator>
+        void FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+        template<class TAllocator>
+        void FindLeavesAlongSegment(const glm::vec2& start, const glm::vec2& end, float_t radius, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+        template<class TLeafVisitor, class TAggregateVisitor>
+        void VisitApproximate(const glm::vec2& point, float_t openingAngle, TLeafVisitor& leafVisitor, TAggregateVisitor& aggregateVisitor) const;
+        void UpdateAggregate();
         void SetRect(Rectangle&& rect);
         bool HasBranches() const { return !m_Branches.empty(); }
         const Rectangle& GetRect() const { return m_Rect; }
-        const std::vector<Branch>& GetBranches() const { return m_Branches; }
-        const std::vector<Leaf*>& GetLeaves() const { return m_Leaves; }
+        const std::pmr::vector<Branch>& GetBranches() const { return m_Branches; }
+        const std::pmr::vector<Leaf*>& GetLeaves() const { return m_Leaves; }
+        const Aggregate& GetAggregate() const { return m_Aggregate; }
         Branch* GetParent() const { return m_Parent; }
         Branch* GetParentsParent() const { return m_Parent ? m_Parent->GetParent() : nullptr; }
     private:
-        std::vector<Branch> m_Branches{};
-        std::vector<Leaf*> m_Leaves{};
+        std::pmr::vector<Branch> m_Branches{};
+        std::pmr::vector<Leaf*> m_Leaves{};
         Rectangle m_Rect{};
         Branch* m_Parent{nullptr};
         uint32_t m_Depth{0};
+        [[no_unique_address]] Aggregate m_Aggregate{};
     };
 
-    bool FindLeaves(const Rectangle& rect, std::vector<Leaf*>& foundLeaves) const;
-    bool FindBranches(const Rectangle& rect, std::vector<Branch*>& foundBranches);
+    QuadtreeConcept() = default;
+    explicit QuadtreeConcept(std::pmr::memory_resource* resource);
+
+    template<class TAllocator>
+    bool FindLeaves(const Rectangle& rect, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+    // Finds Leaves in Branches touched by a circle of radius swept from start to end.
+    template<class TAllocator>
+    bool FindLeavesAlongSegment(const glm::vec2& start, const glm::vec2& end, float_t radius, std::vector<Leaf*, TAllocator>& foundLeaves) const;
+    // Visits the Leaves of every Branch the ray crosses, Branches are visited front to back along the ray.
+    // Each Branch is expanded by padding, the largest distance a Leaf extends from its position, so Leaves
+    // overlapping the ray from a Branch the ray does not cross are still visited.
+    // visitor(leaf, entryDistance) is given the distance the ray enters the Leaf's padded Branch, no part of the
+    // Leaf is closer along the ray. Return false to stop.
+    template<class TVisitor> requires std::predicate<TVisitor&, TLeaf&, float_t>
+    void Raycast(const glm::vec2& origin, const glm::vec2& direction, float_t maxDistance, float_t padding, TVisitor&& visitor) const;
+    // Barnes-Hut style traversal from point. A Branch whose width divided by the distance from point to its
+    // Aggregate's position is below openingAngle is visited as a whole with aggregateVisitor(aggregate),
+    // otherwise it is opened and its Leaves are visited individually with leafVisitor(leaf).
+    template<class TLeafVisitor, class TAggregateVisitor>
+        requires LeafHasGetPositionVec2D<TAggregate> && std::invocable<TLeafVisitor&, TLeaf&> && std::invocable<TAggregateVisitor&, const TAggregate&>
+    void VisitApproximate(const glm::vec2& point, float_t openingAngle, TLeafVisitor&& leafVisitor, TAggregateVisitor&& aggregateVisitor) const;
+    template<class TAllocator>
+    bool FindBranches(const Rectangle& rect, std::vector<Branch*, TAllocator>& foundBranches);
+    template<class TAllocator>
+    bool FindBranches(const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const;
     const Branch& GetRootBranch() const { return m_RootBranch; }
+    std::pmr::memory_resource* GetMemoryResource() const { return m_RootBranch.GetBranches().get_allocator().resource(); }
     Branch* FindBranch(const glm::vec2& point);
+    const Branch* FindBranch(const glm::vec2& point) const;
     void AddLeaf(Leaf* newLeaf);
+    // Recomputes every Branch's Aggregate bottom up, does nothing for NoAggregate.
+    void UpdateAggregates();
     void Reset();
 private:
     Branch m_RootBranch{};
@@ -61,18 +130,82 @@ void RebuildQuadtreeConcept(TQuadtree& quadtree, std::vector<typename TQuadtree:
     {
         quadtree.AddLeaf(&leaf);
     }
+
+    quadtree.UpdateAggregates();
+}
+
+// Reorders leaves to match a depth first walk of the Quadtree, Branches are split Top Left, Top Right,
+// Bottom Left, Bottom Right so this is Z-order (Morton order) down to the leaf Branches. Leaves close in space
+// become close in memory. The Quadtree does not need to be built beforehand, it is built from leaves to find the
+// order and built again from the reordered leaves, so a reorder costs two builds plus moving every Leaf.
+// Returns the new index of each Leaf indexed by its old index, so external handles can be remapped.
+template<class TQuadtree>
+std::vector<uint32_t> ReorderLeavesConcept(TQuadtree& quadtree, std::vector<typename TQuadtree::Leaf>& leaves)
+{
+    using Branch = typename TQuadtree::Branch;
+    using Leaf = typename TQuadtree::Leaf;
+
+    // The walk below must see every Leaf exactly once, a Quadtree built from other Leaves would lose some.
+    RebuildQuadtreeConcept(quadtree, leaves);
+
+    std::vector<uint32_t> newIndices(leaves.size());
+    uint32_t newIndex{0};
+    std::vector<const Branch*> branches{&quadtree.GetRootBranch()};
+    while(!branches.empty())
+    {
+        const Branch& branch{*branches.back()};
+        branches.pop_back();
+
+        for(const Leaf* const leaf : branch.GetLeaves())
+        {
+            newIndices[static_cast<size_t>(leaf - leaves.data())] = newIndex++;
+        }
+
+        // Pushed in reverse so the Top Left Branch is visited first.
+        for(auto childBranch{std::rbegin(branch.GetBranches())}; childBranch != std::rend(branch.GetBranches()); ++childBranch)
+        {
+            branches.push_back(&*childBranch);
+        }
+    }
+    assert(newIndex == leaves.size());
+
+    std::vector<Leaf> reorderedLeaves{};
+    reorderedLeaves.reserve(leaves.size());
+    std::vector<uint32_t> oldIndices(leaves.size());
+    for(uint32_t oldIndex{0}; oldIndex != newIndices.size(); ++oldIndex)
+    {
+        oldIndices[newIndices[oldIndex]] = oldIndex;
+    }
+    for(const uint32_t oldIndex : oldIndices)
+    {
+        reorderedLeaves.push_back(std::move(leaves[oldIndex]));
+    }
+    leaves.swap(reorderedLeaves);
+
+    RebuildQuadtreeConcept(quadtree, leaves);
+    return newIndices;
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::Branch(std::pmr::memory_resource* const resource)
+    : m_Branches{resource}
+    , m_Leaves{resource}
+{
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::Branch(const uint32_t depth, Rectangle&& rect, Branch* const parent)
-    : m_Rect{std::move(rect)}
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::Branch(
+    const uint32_t depth, Rectangle&& rect, Branch* const parent, std::pmr::memory_resource* const resource)
+    : m_Branches{resource}
+    , m_Leaves{resource}
+    , m_Rect{std::move(rect)}
     , m_Parent{parent}
     , m_Depth{depth}
 {
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::AddLeaf(TLeaf* const newLeaf)
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::AddLeaf(TLeaf* const newLeaf)
 {
     if(m_Depth > ChildDepthThreshold || SplitThreshold > m_Leaves.size())
     {
@@ -85,15 +218,16 @@ void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::AddLea
     const float_t width{m_Rect.GetWidth() * 0.5f};
     const float_t height{m_Rect.GetHeight() * 0.5f};
     const glm::vec2& topLeft{m_Rect.GetTopLeft()};
+    std::pmr::memory_resource* const resource{m_Branches.get_allocator().resource()};
 
     // Top Left
-    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft, width, height}, this);
+    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft, width, height}, this, resource);
     // Top Right
-    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{width, 0.0f}, width, height}, this);
+    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{width, 0.0f}, width, height}, this, resource);
     // Bottom Left
-    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{0.0f, height}, width, height}, this);
+    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{0.0f, height}, width, height}, this, resource);
     // Bottom Right
-    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{width, height}, width, height}, this);
+    m_Branches.emplace_back(m_Depth + 1, Rectangle{topLeft + glm::vec2{width, height}, width, height}, this, resource);
 
     {
         Branch* const branch{FindBranch(*this, newLeaf->GetPosition())};
@@ -109,31 +243,40 @@ void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::AddLea
     m_Leaves.clear();
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::Reset()
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::Reset()
 {
-    m_Branches.clear();
-    m_Leaves.clear();
+    // Swap out the storage as well as the elements so nothing is left pointing into the memory resource.
+    std::pmr::vector<Branch>{m_Branches.get_allocator()}.swap(m_Branches);
+    std::pmr::vector<TLeaf*>{m_Leaves.get_allocator()}.swap(m_Leaves);
     m_Rect = {};
     m_Parent = nullptr;
     m_Depth = 0;
+    m_Aggregate = {};
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::SetRect(Rectangle&& rect)
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::SetRect(Rectangle&& rect)
 {
     m_Rect = std::move(rect);
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::FindBranch(
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindBranch(
     Branch& branch, const glm::vec2& point)
+{
+    return const_cast<Branch*>(FindBranch(std::as_const(branch), point));
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+const QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindBranch(
+    const Branch& branch, const glm::vec2& point)
 {
     if(CollisionRectPoint(branch.m_Rect, point))
     {
-        for(Branch& childBranch : branch.m_Branches)
+        for(const Branch& childBranch : branch.m_Branches)
         {
-            if(Branch* const foundBranch{FindBranch(childBranch, point)})
+            if(const Branch* const foundBranch{FindBranch(childBranch, point)})
             {
                 return foundBranch;
             }
@@ -145,9 +288,10 @@ QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch* QuadtreeCon
     return nullptr;
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::FindBranches(
-    const Rectangle& rect, std::vector<Branch*>& foundBranches)
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindBranches(
+    const Rectangle& rect, std::vector<Branch*, TAllocator>& foundBranches)
 {
     if(!HasBranches() && CollisionRectRect(rect, m_Rect))
     {
@@ -161,9 +305,27 @@ void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::FindBr
     }
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::FindLeaves(
-    const Rectangle& rect, std::vector<TLeaf*>& foundLeaves) const
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindBranches(
+    const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const
+{
+    if(!HasBranches() && CollisionRectRect(rect, m_Rect))
+    {
+        foundBranches.push_back(this);
+        return;
+    }
+
+    for(const Branch& childBranch : m_Branches)
+    {
+        childBranch.FindBranches(rect, foundBranches);
+    }
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindLeaves(
+    const Rectangle& rect, std::vector<TLeaf*, TAllocator>& foundLeaves) const
 {
     if(!HasBranches() && CollisionRectRect(rect, m_Rect))
     {
@@ -177,42 +339,205 @@ void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch::FindLe
     }
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Reset()
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::FindLeavesAlongSegment(
+    const glm::vec2& start, const glm::vec2& end, const float_t radius, std::vector<TLeaf*, TAllocator>& foundLeaves) const
+{
+    // Sweeping a circle against a rect is the same as sweeping a point against the rect grown by the radius.
+    if(!CollisionSegmentRect(start, end, ExpandRect(m_Rect, radius)))
+    {
+        return;
+    }
+
+    if(!HasBranches())
+    {
+        foundLeaves.insert(std::end(foundLeaves), std::begin(m_Leaves), std::end(m_Leaves));
+        return;
+    }
+
+    for(const Branch& childBranch : m_Branches)
+    {
+        childBranch.FindLeavesAlongSegment(start, end, radius, foundLeaves);
+    }
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TLeafVisitor, class TAggregateVisitor>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::VisitApproximate(
+    const glm::vec2& point, const float_t openingAngle, TLeafVisitor& leafVisitor, TAggregateVisitor& aggregateVisitor) const
+{
+    if(!CollisionRectPoint(m_Rect, point))
+    {
+        const float_t distance{glm::length(m_Aggregate.GetPosition() - point)};
+        if(m_Rect.GetWidth() < openingAngle * distance)
+        {
+            aggregateVisitor(m_Aggregate);
+            return;
+        }
+    }
+
+    for(TLeaf* const leaf : m_Leaves)
+    {
+        leafVisitor(*leaf);
+    }
+
+    for(const Branch& childBranch : m_Branches)
+    {
+        childBranch.VisitApproximate(point, openingAngle, leafVisitor, aggregateVisitor);
+    }
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch::UpdateAggregate()
+{
+    m_Aggregate = {};
+
+    for(Branch& childBranch : m_Branches)
+    {
+        childBranch.UpdateAggregate();
+        m_Aggregate.AddAggregate(childBranch.m_Aggregate);
+    }
+
+    for(const TLeaf* const leaf : m_Leaves)
+    {
+        m_Aggregate.AddLeaf(*leaf);
+    }
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::QuadtreeConcept(std::pmr::memory_resource* const resource)
+    : m_RootBranch{resource}
+{
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Reset()
 {
     m_RootBranch.Reset();
     m_RootBranch.SetRect(Rectangle{glm::vec2{0.0f, 0.0f}, static_cast<float_t>(WINDOW_WIDTH), static_cast<float_t>(WINDOW_HEIGHT)});
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::FindBranch(
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindBranch(
     const glm::vec2& point)
 {
     return Branch::FindBranch(m_RootBranch, point);
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::FindBranches(
-    const Rectangle& rect, std::vector<Branch*>& foundBranches)
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+const QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Branch* QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindBranch(
+    const glm::vec2& point) const
+{
+    return Branch::FindBranch(m_RootBranch, point);
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindBranches(
+    const Rectangle& rect, std::vector<Branch*, TAllocator>& foundBranches)
+{
+    assert(foundBranches.empty());
+    m_RootBranch.FindBranches(rect, foundBranches);
+    return !foundBranches.empty();
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindBranches(
+    const Rectangle& rect, std::vector<const Branch*, TAllocator>& foundBranches) const
 {
     assert(foundBranches.empty());
     m_RootBranch.FindBranches(rect, foundBranches);
     return !foundBranches.empty();
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::FindLeaves(
-    const Rectangle& rect, std::vector<TLeaf*>& foundLeaves) const
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindLeaves(
+    const Rectangle& rect, std::vector<TLeaf*, TAllocator>& foundLeaves) const
 {
     assert(foundLeaves.empty());
     m_RootBranch.FindLeaves(rect, foundLeaves);
     return !foundLeaves.empty();
 }
 
-template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold> requires LeafHasGetPositionVec2D<TLeaf>
-void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold>::AddLeaf(TLeaf* const newLeaf)
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::AddLeaf(TLeaf* const newLeaf)
 {
     Branch* const branch{FindBranch(newLeaf->GetPosition())};
     assert(branch);
     branch->AddLeaf(newLeaf);
 }
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TAllocator>
+bool QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::FindLeavesAlongSegment(
+    const glm::vec2& start, const glm::vec2& end, const float_t radius, std::vector<TLeaf*, TAllocator>& foundLeaves) const
+{
+    assert(foundLeaves.empty());
+    m_RootBranch.FindLeavesAlongSegment(start, end, radius, foundLeaves);
+    return !foundLeaves.empty();
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TVisitor> requires std::predicate<TVisitor&, TLeaf&, float_t>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::Raycast(
+    const glm::vec2& origin, const glm::vec2& direction, const float_t maxDistance, const float_t padding, TVisitor&& visitor) const
+{
+    const glm::vec2 end{origin + glm::normalize(direction) * maxDistance};
+
+    // Padded siblings overlap, so a depth first walk is not front to back. Always continue from the crossed
+    // Branch entered first instead, a child is never entered before its parent.
+    using CrossedBranch = std::pair<float_t, const Branch*>;
+    const auto enteredLater = [](const CrossedBranch& lhs, const CrossedBranch& rhs) { return lhs.first > rhs.first; };
+    std::vector<CrossedBranch> crossedBranches{};
+
+    float_t entryTime{0.0f};
+    if(IntersectSegmentRect(origin, end, ExpandRect(m_RootBranch.GetRect(), padding), entryTime))
+    {
+        crossedBranches.emplace_back(entryTime * maxDistance, &m_RootBranch);
+    }
+
+    while(!crossedBranches.empty())
+    {
+        std::ranges::pop_heap(crossedBranches, enteredLater);
+        const auto [entryDistance, branch] {crossedBranches.back()};
+        crossedBranches.pop_back();
+
+        for(TLeaf* const leaf : branch->GetLeaves())
+        {
+            if(!visitor(*leaf, entryDistance))
+            {
+                return;
+            }
+        }
+
+        for(const Branch& childBranch : branch->GetBranches())
+        {
+            if(IntersectSegmentRect(origin, end, ExpandRect(childBranch.GetRect(), padding), entryTime))
+            {
+                crossedBranches.emplace_back(entryTime * maxDistance, &childBranch);
+                std::ranges::push_heap(crossedBranches, enteredLater);
+            }
+        }
+    }
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+template<class TLeafVisitor, class TAggregateVisitor>
+    requires LeafHasGetPositionVec2D<TAggregate> && std::invocable<TLeafVisitor&, TLeaf&> && std::invocable<TAggregateVisitor&, const TAggregate&>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::VisitApproximate(
+    const glm::vec2& point, const float_t openingAngle, TLeafVisitor&& leafVisitor, TAggregateVisitor&& aggregateVisitor) const
+{
+    m_RootBranch.VisitApproximate(point, openingAngle, leafVisitor, aggregateVisitor);
+}
+
+template<class TLeaf, uint32_t SplitThreshold, uint32_t ChildDepthThreshold, class TAggregate> requires LeafHasGetPositionVec2D<TLeaf> && AggregateReducesLeaves<TAggregate, TLeaf>
+void QuadtreeConcept<TLeaf, SplitThreshold, ChildDepthThreshold, TAggregate>::UpdateAggregates()
+{
+    if constexpr(!std::is_same_v<TAggregate, NoAggregate>)
+    {
+        m_RootBranch.UpdateAggregate();
+    }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include "quadtreeconcept.h"
+#include "shapeprimitives.h"
+
+// Tracks which Leaves are inside each subscribed region and reports Leaves entering and leaving them.
+// Each Update attaches every subscription to the leaf Branches its region overlaps, then only tests Leaves
+// against the subscriptions attached to their own Branch. Leaves in Branches without subscribers that were
+// not inside any region last Update cost a single check.
+// Leaves are identified by their index in the vector the Quadtree was built from, pass the indices returned by
+// ReorderLeavesConcept to RemapLeaves so reordered Leaves are not reported as leaving and entering.
+// Subscription ids are never reused.
+template<class TQuadtree>
+class QuadtreeSubscriptionsConcept
+{
+public:
+    using Quadtree = TQuadtree;
+    using Leaf = typename TQuadtree::Leaf;
+    using Branch = typename TQuadtree::Branch;
+
+    uint32_t Subscribe(const Rectangle& region);
+    void Unsubscribe(uint32_t subscription);
+    void SetRegion(uint32_t subscription, const Rectangle& region);
+    // Moves each Leaf's memberships from its old index to newIndices[oldIndex].
+    void RemapLeaves(std::span<const uint32_t> newIndices);
+    // onEnter(subscription, leafIndex) and onExit(subscription, leafIndex) are called for every change since the
+    // last Update. Leaves of removed subscriptions, and Leaves past the end of leaves, are reported as exiting.
+    template<class TEnterVisitor, class TExitVisitor>
+        requires std::invocable<TEnterVisitor&, uint32_t, uint32_t> && std::invocable<TExitVisitor&, uint32_t, uint32_t>
+    void Update(const Quadtree& quadtree, const std::vector<Leaf>& leaves, TEnterVisitor&& onEnter, TExitVisitor&& onExit);
+    const std::vector<uint32_t>& GetSubscriptions(uint32_t leafIndex) const { return m_Memberships[leafIndex]; }
+private:
+    struct Subscription
+    {
+        Rectangle m_Region{};
+        bool m_Active{false};
+    };
+
+    template<class TEnterVisitor, class TExitVisitor>
+    void UpdateBranch(const Branch& branch, const std::vector<Leaf>& leaves, TEnterVisitor& onEnter, TExitVisitor& onExit);
+
+    std::vector<Subscription> m_Subscriptions{};
+    // Subscriptions attached to each leaf Branch for the current Update, sorted by Branch.
+    std::vector<std::pair<const Branch*, uint32_t>> m_BranchSubscribers{};
+    // Sorted subscription ids each Leaf was inside at the last Update.
+    std::vector<std::vector<uint32_t>> m_Memberships{};
+    std::vector<std::vector<uint32_t>> m_RemappedMemberships{};
+    std::vector<uint32_t> m_Candidates{};
+    std::vector<uint32_t> m_NewMembership{};
+    std::vector<const Branch*> m_FoundBranches{};
+};
+
+template<class TQuadtree>
+uint32_t QuadtreeSubscriptionsConcept<TQuadtree>::Subscribe(const Rectangle& region)
+{
+    m_Subscriptions.push_back(Subscription{region, true});
+    return static_cast<uint32_t>(m_Subscriptions.size() - 1);
+}
+
+template<class TQuadtree>
+void QuadtreeSubscriptionsConcept<TQuadtree>::Unsubscribe(const uint32_t subscription)
+{
+    assert(subscription < m_Subscriptions.size());
+    m_Subscriptions[subscription].m_Active = false;
+}
+
+template<class TQuadtree>
+void QuadtreeSubscriptionsConcept<TQuadtree>::SetRegion(const uint32_t subscription, const Rectangle& region)
+{
+    assert(subscription < m_Subscriptions.size() && m_Subscriptions[subscription].m_Active);
+    m_Subscriptions[subscription].m_Region = region;
+}
+
+template<class TQuadtree>
+void QuadtreeSubscriptionsConcept<TQuadtree>::RemapLeaves(const std::span<const uint32_t> newIndices)
+{
+    // Leaves added since the last Update have no memberships yet.
+    assert(m_Memberships.size() <= newIndices.size());
+    m_RemappedMemberships.resize(newIndices.size());
+    for(uint32_t oldIndex{0}; oldIndex != m_Memberships.size(); ++oldIndex)
+    {
+        m_RemappedMemberships[newIndices[oldIndex]].swap(m_Memberships[oldIndex]);
+    }
+    m_Memberships.swap(m_RemappedMemberships);
+    m_RemappedMemberships.clear();
+}
+
+template<class TQuadtree>
+template<class TEnterVisitor, class TExitVisitor>
+    requires std::invocable<TEnterVisitor&, uint32_t, uint32_t> && std::invocable<TExitVisitor&, uint32_t, uint32_t>
+void QuadtreeSubscriptionsConcept<TQuadtree>::Update(
+    const Quadtree& quadtree, const std::vector<Leaf>& leaves, TEnterVisitor&& onEnter, TExitVisitor&& onExit)
+{
+    // Removed Leaves leave every region they were inside before their memberships are dropped.
+    for(uint32_t leafIndex{static_cast<uint32_t>(leaves.size())}; leafIndex < m_Memberships.size(); ++leafIndex)
+    {
+        for(const uint32_t subscription : m_Memberships[leafIndex])
+        {
+            onExit(subscription, leafIndex);
+        }
+    }
+    m_Memberships.resize(leaves.size());
+
+    m_BranchSubscribers.clear();
+    for(uint32_t subscription{0}; subscription != m_Subscriptions.size(); ++subscription)
+    {
+        if(!m_Subscriptions[subscription].m_Active)
+            continue;
+
+        m_FoundBranches.clear();
+        quadtree.FindBranches(m_Subscriptions[subscription].m_Region, m_FoundBranches);
+        for(const Branch* const branch : m_FoundBranches)
+        {
+            m_BranchSubscribers.emplace_back(branch, subscription);
+        }
+    }
+    std::ranges::sort(m_BranchSubscribers);
+
+    UpdateBranch(quadtree.GetRootBranch(), leaves, onEnter, onExit);
+}
+
+template<class TQuadtree>
+template<class TEnterVisitor, class TExitVisitor>
+void QuadtreeSubscriptionsConcept<TQuadtree>::UpdateBranch(
+    const Branch& branch, const std::vector<Leaf>& leaves, TEnterVisitor& onEnter, TExitVisitor& onExit)
+{
+    for(const Branch& childBranch : branch.GetBranches())
+    {
+        UpdateBranch(childBranch, leaves, onEnter, onExit);
+    }
+
+    if(branch.GetLeaves().empty())
+        return;
+
+    m_Candidates.clear();
+    const auto [first, last] {std::ranges::equal_range(m_BranchSubscribers, &branch, {}, &std::pair<const Branch*, uint32_t>::first)};
+    for(auto subscriber{first}; subscriber != last; ++subscriber)
+    {
+        m_Candidates.push_back(subscriber->second);
+    }
+
+    for(const Leaf* const leaf : branch.GetLeaves())
+    {
+        const uint32_t leafIndex{static_cast<uint32_t>(leaf - leaves.data())};
+        std::vector<uint32_t>& membership{m_Memberships[leafIndex]};
+        if(m_Candidates.empty() && membership.empty())
+            continue;
+
+        // Candidates are already sorted by subscription id.
+        m_NewMembership.clear();
+        for(const uint32_t subscription : m_Candidates)
+        {
+            if(CollisionRectPoint(m_Subscriptions[subscription].m_Region, leaf->GetPosition()))
+            {
+                m_NewMembership.push_back(subscription);
+            }
+        }
+
+        auto previous{std::begin(membership)};
+        auto current{std::begin(m_NewMembership)};
+        while(previous != std::end(membership) || current != std::end(m_NewMembership))
+        {
+            if(current == std::end(m_NewMembership) || (previous != std::end(membership) && *previous < *current))
+            {
+                onExit(*previous++, leafIndex);
+            }
+            else if(previous == std::end(membership) || *current < *previous)
+            {
+                onEnter(*current++, leafIndex);
+            }
+            else
+            {
+                ++previous;
+                ++current;
+            }
+        }
+
+        membership.assign(std::begin(m_NewMembership), std::end(m_NewMembership));
+    }
+}
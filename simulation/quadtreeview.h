@@ -0,0 +1,75 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "quadtreeconcept.h"
+
+// Read only view of a built Quadtree. Every query is const and only reads the Quadtree, so any number of
+// threads can query the same Quadtree at once as long as nothing rebuilds it in the meantime.
+// Results are written to a scratch buffer owned by the calling thread, the returned span is valid until the
+// next query of the same kind on that thread.
+template<class TQuadtree>
+class QuadtreeViewConcept
+{
+public:
+    using Quadtree = TQuadtree;
+    using Leaf = typename TQuadtree::Leaf;
+    using Branch = typename TQuadtree::Branch;
+
+    explicit QuadtreeViewConcept(const Quadtree& quadtree);
+
+    std::span<const Leaf* const> FindLeaves(const Rectangle& rect) const;
+    std::span<const Branch* const> FindBranches(const Rectangle& rect) const;
+    const Branch* FindBranch(const glm::vec2& point) const;
+    const Quadtree& GetQuadtree() const { return *m_Quadtree; }
+private:
+    static std::vector<Leaf*>& GetLeafScratch();
+    static std::vector<const Branch*>& GetBranchScratch();
+
+    const Quadtree* m_Quadtree{nullptr};
+};
+
+template<class TQuadtree>
+QuadtreeViewConcept<TQuadtree>::QuadtreeViewConcept(const Quadtree& quadtree)
+    : m_Quadtree{&quadtree}
+{
+}
+
+template<class TQuadtree>
+std::span<const typename TQuadtree::Leaf* const> QuadtreeViewConcept<TQuadtree>::FindLeaves(const Rectangle& rect) const
+{
+    std::vector<Leaf*>& foundLeaves{GetLeafScratch()};
+    foundLeaves.clear();
+    m_Quadtree->FindLeaves(rect, foundLeaves);
+    return foundLeaves;
+}
+
+template<class TQuadtree>
+std::span<const typename TQuadtree::Branch* const> QuadtreeViewConcept<TQuadtree>::FindBranches(const Rectangle& rect) const
+{
+    std::vector<const Branch*>& foundBranches{GetBranchScratch()};
+    foundBranches.clear();
+    m_Quadtree->FindBranches(rect, foundBranches);
+    return foundBranches;
+}
+
+template<class TQuadtree>
+const typename TQuadtree::Branch* QuadtreeViewConcept<TQuadtree>::FindBranch(const glm::vec2& point) const
+{
+    return m_Quadtree->FindBranch(point);
+}
+
+template<class TQuadtree>
+std::vector<typename TQuadtree::Leaf*>& QuadtreeViewConcept<TQuadtree>::GetLeafScratch()
+{
+    thread_local std::vector<Leaf*> scratch{};
+    return scratch;
+}
+
+template<class TQuadtree>
+std::vector<const typename TQuadtree::Branch*>& QuadtreeViewConcept<TQuadtree>::GetBranchScratch()
+{
+    thread_local std::vector<const Branch*> scratch{};
+    return scratch;
+}
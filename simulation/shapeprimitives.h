@@ -8,6 +8,8 @@ inline constexpr float_t MIN_RADIUS{1.0f};
 inline constexpr float_t MAX_RADIUS{8.0f};
 inline constexpr float_t MIN_VELOCITY{50.0f};
 inline constexpr float_t MAX_VELOCITY{200.0f};
+inline constexpr float_t GRAVITATIONAL_CONSTANT{1000.0f};
+inline constexpr float_t GRAVITY_SOFTENING{MAX_RADIUS};
 
 struct Circle
 {
@@ -27,6 +29,14 @@ struct Circle
     float_t m_Mass{0.0f};
 };
 
+inline glm::vec2 GravitationalAcceleration(const glm::vec2& position, const glm::vec2& otherPosition, const float_t otherMass)
+{
+    // Softened so overlapping circles don't produce huge accelerations.
+    const glm::vec2 toOther{otherPosition - position};
+    const float_t distanceSquared{glm::length2(toOther) + GRAVITY_SOFTENING * GRAVITY_SOFTENING};
+    return toOther * (GRAVITATIONAL_CONSTANT * otherMass / (distanceSquared * glm::sqrt(distanceSquared)));
+}
+
 inline void ClampPositionToWindow(glm::vec2& spawnPosition)
 {
     spawnPosition.x = glm::fclamp(spawnPosition.x, 0.0f, static_cast<float_t>(WINDOW_WIDTH));
@@ -134,6 +144,93 @@ inline bool CollisionRectRect(const Rectangle& rectA, const Rectangle& rectB)
     return false;
 }
 
+inline Rectangle ExpandRect(const Rectangle& rect, const float_t amount)
+{
+    return Rectangle{rect.GetTopLeft() - glm::vec2{amount, amount}, rect.GetWidth() + amount * 2.0f, rect.GetHeight() + amount * 2.0f};
+}
+
+// entryTime is the fraction along start -> end where the segment enters the rect, 0 if start is inside.
+inline bool IntersectSegmentRect(const glm::vec2& start, const glm::vec2& end, const Rectangle& rect, float_t& entryTime)
+{
+    // https://tavianator.com/2011/ray_box.html
+    const glm::vec2 direction{end - start};
+    const glm::vec2& rectMin{rect.GetTopLeft()};
+    const glm::vec2 rectMax{rect.GetBottomRight()};
+    float_t tMin{0.0f};
+    float_t tMax{1.0f};
+
+    for(int32_t axis{0}; axis != 2; ++axis)
+    {
+        if(direction[axis] == 0.0f)
+        {
+            if(start[axis] < rectMin[axis] || start[axis] > rectMax[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        const float_t inverseDirection{1.0f / direction[axis]};
+        float_t tNear{(rectMin[axis] - start[axis]) * inverseDirection};
+        float_t tFar{(rectMax[axis] - start[axis]) * inverseDirection};
+        if(tNear > tFar)
+        {
+            std::swap(tNear, tFar);
+        }
+
+        tMin = glm::max(tMin, tNear);
+        tMax = glm::min(tMax, tFar);
+        if(tMin > tMax)
+        {
+            return false;
+        }
+    }
+
+    entryTime = tMin;
+    return true;
+}
+
+inline bool CollisionSegmentRect(const glm::vec2& start, const glm::vec2& end, const Rectangle& rect)
+{
+    float_t entryTime{0.0f};
+    return IntersectSegmentRect(start, end, rect, entryTime);
+}
+
+// direction must be normalized, distance is 0 if origin is inside the circle.
+inline bool IntersectRayCircle(
+    const glm::vec2& origin, const glm::vec2& direction, const float_t maxDistance, const Circle& circle, float_t& distance)
+{
+    const glm::vec2 toOrigin{origin - circle.m_Position};
+    const float_t c{glm::length2(toOrigin) - circle.m_Radius * circle.m_Radius};
+    if(c <= 0.0f)
+    {
+        distance = 0.0f;
+        return true;
+    }
+
+    const float_t b{glm::dot(toOrigin, direction)};
+    if(b > 0.0f)
+    {
+        // Origin is outside and pointing away.
+        return false;
+    }
+
+    const float_t discriminant{b * b - c};
+    if(discriminant < 0.0f)
+    {
+        return false;
+    }
+
+    const float_t hitDistance{-b - glm::sqrt(discriminant)};
+    if(hitDistance > maxDistance)
+    {
+        return false;
+    }
+
+    distance = hitDistance;
+    return true;
+}
+
 inline void ResolveCollisionCircleEdgeOfScreen(Circle& circle)
 {
     static constexpr glm::vec2 topEdgeNormal{0.0f, -1.0f};
@@ -164,6 +261,16 @@ inline void ResolveCollisionCircleEdgeOfScreen(Circle& circle)
     }
 }
 
+inline void ResolveElasticVelocityCircleCircle(Circle& circleA, Circle& circleB)
+{
+    // https://blogs.love2d.org/content/circle-collisions
+    const glm::vec2 total{circleA.m_Velocity - circleB.m_Velocity};
+    const glm::vec2 velocityA{(circleA.m_Velocity * (circleA.m_Mass - circleB.m_Mass) + (2.0f * circleB.m_Mass * circleB.m_Velocity)) / (circleA.m_Mass + circleB.m_Mass)};
+    const glm::vec2 velocityB{total + velocityA};
+    circleA.m_Velocity = velocityA;
+    circleB.m_Velocity = velocityB;
+}
+
 inline void ResolveElasticCollisionCircleCircle(Circle& circleA, Circle& circleB)
 {
     if(circleA.m_Position == circleB.m_Position)
@@ -177,12 +284,7 @@ inline void ResolveElasticCollisionCircleCircle(Circle& circleA, Circle& circleB
 
     if(radiusSum > distance)
     {
-        // https://blogs.love2d.org/content/circle-collisions
-        const glm::vec2 total{circleA.m_Velocity - circleB.m_Velocity};
-        const glm::vec2 velocityA{(circleA.m_Velocity * (circleA.m_Mass - circleB.m_Mass) + (2.0f * circleB.m_Mass * circleB.m_Velocity)) / (circleA.m_Mass + circleB.m_Mass)};
-        const glm::vec2 velocityB{total + velocityA};
-        circleA.m_Velocity = velocityA;
-        circleB.m_Velocity = velocityB;
+        ResolveElasticVelocityCircleCircle(circleA, circleB);
 
         const float_t halfOverlap{(radiusSum - distance) * 0.5f};
         const glm::vec2 toInnerNormalized{glm::normalize(toCircleB)};
@@ -190,3 +292,87 @@ inline void ResolveElasticCollisionCircleCircle(Circle& circleA, Circle& circleB
         circleA.m_Position -= toInnerNormalized * halfOverlap;
     }
 }
+
+// Bounces circle off an immovable circle, as if staticCircle had infinite mass.
+inline void ResolveCollisionCircleStaticCircle(Circle& circle, const Circle& staticCircle)
+{
+    const float_t radiusSum{circle.m_Radius + staticCircle.m_Radius};
+    const glm::vec2 fromStaticCircle{circle.m_Position - staticCircle.m_Position};
+    const float_t distance{glm::length(fromStaticCircle)};
+
+    if(radiusSum > distance)
+    {
+        const glm::vec2 normal{distance > 0.0f ? fromStaticCircle / distance : glm::vec2{1.0f, 0.0f}};
+        if(glm::dot(circle.m_Velocity, normal) < 0.0f)
+        {
+            circle.m_Velocity = glm::reflect(circle.m_Velocity, normal);
+        }
+        circle.m_Position = staticCircle.m_Position + normal * radiusSum;
+    }
+}
+
+// Finds the earliest time within [0, maxTime] at which the approaching circles touch, 0 if already overlapping.
+inline bool TimeOfImpactCircleCircle(const Circle& circleA, const Circle& circleB, const float_t maxTime, float_t& timeOfImpact)
+{
+    // Solve |toCircleB + relativeVelocity * t| = radiusSum for t.
+    const glm::vec2 toCircleB{circleB.m_Position - circleA.m_Position};
+    const glm::vec2 relativeVelocity{circleB.m_Velocity - circleA.m_Velocity};
+    const float_t radiusSum{circleA.m_Radius + circleB.m_Radius};
+
+    const float_t b{glm::dot(toCircleB, relativeVelocity)};
+    if(b >= 0.0f)
+    {
+        // Not moving relative to each other or moving apart.
+        return false;
+    }
+
+    const float_t c{glm::length2(toCircleB) - radiusSum * radiusSum};
+    if(c < 0.0f)
+    {
+        timeOfImpact = 0.0f;
+        return true;
+    }
+
+    const float_t a{glm::length2(relativeVelocity)};
+
+    const float_t discriminant{b * b - a * c};
+    if(discriminant < 0.0f)
+    {
+        return false;
+    }
+
+    const float_t time{(-b - glm::sqrt(discriminant)) / a};
+    if(time > maxTime)
+    {
+        return false;
+    }
+
+    timeOfImpact = time;
+    return true;
+}
+
+// Resolves a collision at the time of impact within the frame instead of only at the current positions, so fast
+// circles can not pass through each other. Positions are set so that integrating velocity over delta places the
+// circles where they would be after bouncing at the time of impact.
+inline void ResolveSweptCollisionCircleCircle(Circle& circleA, Circle& circleB, const float_t delta)
+{
+    float_t timeOfImpact{0.0f};
+    if(!TimeOfImpactCircleCircle(circleA, circleB, delta, timeOfImpact))
+    {
+        return;
+    }
+
+    if(timeOfImpact == 0.0f)
+    {
+        ResolveElasticCollisionCircleCircle(circleA, circleB);
+        return;
+    }
+
+    const glm::vec2 contactA{circleA.m_Position + circleA.m_Velocity * timeOfImpact};
+    const glm::vec2 contactB{circleB.m_Position + circleB.m_Velocity * timeOfImpact};
+
+    ResolveElasticVelocityCircleCircle(circleA, circleB);
+
+    circleA.m_Position = contactA - circleA.m_Velocity * timeOfImpact;
+    circleB.m_Position = contactB - circleB.m_Velocity * timeOfImpact;
+}
@@ -1,11 +1,13 @@
 #include "stdafx.h"
 #include "simulation.h"
 
+#include <algorithm>
 #include <ranges>
+#include <utility>
 
 void UpdateCirclesQuadtreeFoundLeaves(std::vector<Circle>& circles, Quadtree& quadtree, const float_t delta)
 {
-    std::vector<Quadtree::Leaf*> foundLeaves{};
+    std::pmr::vector<Quadtree::Leaf*> foundLeaves{quadtree.GetMemoryResource()};
     for(Circle& circle : circles)
     {
         foundLeaves.clear();
@@ -27,7 +29,7 @@ void UpdateCirclesQuadtreeFoundLeaves(std::vector<Circle>& circles, Quadtree& qu
 
 void UpdateCirclesQuadtreeFoundBranches(std::vector<Circle>& circles, Quadtree& quadtree, const float_t delta)
 {
-    std::vector<Quadtree::Branch*> foundBranches{};
+    std::pmr::vector<Quadtree::Branch*> foundBranches{quadtree.GetMemoryResource()};
     for(Circle& circle : circles)
     {
         foundBranches.clear();
@@ -52,7 +54,7 @@ void UpdateCirclesQuadtreeFoundBranches(std::vector<Circle>& circles, Quadtree&
 
 void UpdateCirclesQuadtreeInnerLoop(Quadtree& quadtree, const Quadtree::Branch& branch, const float_t delta)
 {
-    std::vector<Quadtree::Branch*> foundBranches{};
+    std::pmr::vector<Quadtree::Branch*> foundBranches{quadtree.GetMemoryResource()};
     for(Circle* const circle : branch.GetLeaves())
     {
         const float_t widthHeight{circle->m_Radius * 2.0f};
@@ -101,6 +103,93 @@ void UpdateCirclesQuadtreeInnerLoop(Quadtree& quadtree, const Quadtree::Branch&
     }
 }
 
+void UpdateCirclesQuadtreeSwept(std::vector<Circle>& circles, Quadtree& quadtree, const float_t delta)
+{
+    // Other circles can move up to the fastest circle's speed * delta towards this one and be up to MAX_RADIUS in
+    // size. Collisions can leave circles faster than MAX_VELOCITY, so the fastest speed is found each update and
+    // raised as collisions are resolved.
+    float_t maxSpeed{0.0f};
+    for(const Circle& circle : circles)
+    {
+        maxSpeed = glm::max(maxSpeed, glm::length(circle.m_Velocity));
+    }
+
+    // A resolved pair is left on paths that pass through each other, so it is only resolved once per update.
+    // Impacts are rare compared to the pairs tested, so a linear search of the resolved pairs is cheap.
+    std::pmr::vector<std::pair<const Circle*, const Circle*>> resolvedPairs{quadtree.GetMemoryResource()};
+    std::pmr::vector<Quadtree::Leaf*> foundLeaves{quadtree.GetMemoryResource()};
+    for(Circle& circle : circles)
+    {
+        foundLeaves.clear();
+        const glm::vec2 end{circle.m_Position + circle.m_Velocity * delta};
+        const float_t otherCirclePadding{MAX_RADIUS + maxSpeed * delta};
+        quadtree.FindLeavesAlongSegment(circle.m_Position, end, circle.m_Radius + otherCirclePadding, foundLeaves);
+
+        for(Circle* const otherCircle : foundLeaves)
+        {
+            if(&circle == otherCircle)
+                continue;
+
+            float_t timeOfImpact{0.0f};
+            if(!TimeOfImpactCircleCircle(circle, *otherCircle, delta, timeOfImpact))
+                continue;
+
+            const std::pair<const Circle*, const Circle*> pair{std::min<const Circle*>(&circle, otherCircle), std::max<const Circle*>(&circle, otherCircle)};
+            if(std::ranges::find(resolvedPairs, pair) != std::end(resolvedPairs))
+                continue;
+
+            resolvedPairs.push_back(pair);
+            ResolveSweptCollisionCircleCircle(circle, *otherCircle, delta);
+            maxSpeed = glm::max(maxSpeed, glm::max(glm::length(circle.m_Velocity), glm::length(otherCircle->m_Velocity)));
+        }
+    }
+
+    // Moved only once every pair is resolved, so each time of impact compares both circles at the start of the frame.
+    for(Circle& circle : circles)
+    {
+        circle.m_Position += circle.m_Velocity * delta;
+    }
+}
+
+void UpdateCirclesLayeredQuadtree(std::vector<Circle>& dynamicCircles, const LayeredQuadtree& quadtree, const float_t delta)
+{
+    // Padded by the largest radius so both circles of an overlapping pair find each other.
+    const auto getBounds = [](const Circle& circle)
+    {
+        const float_t halfWidthHeight{circle.m_Radius + MAX_RADIUS};
+        return Rectangle{circle.m_Position - glm::vec2{halfWidthHeight, halfWidthHeight}, halfWidthHeight * 2.0f, halfWidthHeight * 2.0f};
+    };
+
+    quadtree.VisitPairs(getBounds,
+        [](Circle& circle, Circle& otherCircle)
+        {
+            ResolveElasticCollisionCircleCircle(circle, otherCircle);
+        },
+        [](Circle& circle, const Circle& staticCircle)
+        {
+            ResolveCollisionCircleStaticCircle(circle, staticCircle);
+        });
+
+    for(Circle& circle : dynamicCircles)
+    {
+        circle.m_Position += circle.m_Velocity * delta;
+    }
+}
+
+void UpdateCirclesSweepAndPrune(std::vector<Circle>& circles, SweepAndPrune& sweepAndPrune, const float_t delta)
+{
+    sweepAndPrune.Update(circles);
+    sweepAndPrune.VisitOverlappingPairs(circles, [](Circle& circle, Circle& otherCircle)
+    {
+        ResolveElasticCollisionCircleCircle(circle, otherCircle);
+    });
+
+    for(Circle& circle : circles)
+    {
+        circle.m_Position += circle.m_Velocity * delta;
+    }
+}
+
 void UpdateCirclesBruteForce(std::vector<Circle>& circles, const float_t delta)
 {
     const uint32_t size{static_cast<uint32_t>(circles.size())};
@@ -119,3 +208,78 @@ void UpdateCirclesBruteForce(std::vector<Circle>& circles, const float_t delta)
         circle.m_Position += circle.m_Velocity * delta;
     }
 }
+
+void ApplyGravityQuadtree(std::vector<Circle>& circles, const MassQuadtree& quadtree, const float_t openingAngle, const float_t delta)
+{
+    // Accumulate first so every circle sees the masses at the same positions the aggregates were built from.
+    std::vector<glm::vec2> accelerations(circles.size());
+    for(size_t i{0}; i != circles.size(); ++i)
+    {
+        const Circle& circle{circles[i]};
+        glm::vec2& acceleration{accelerations[i]};
+        quadtree.VisitApproximate(circle.m_Position, openingAngle,
+            [&circle, &acceleration](const Circle& otherCircle)
+            {
+                if(&circle != &otherCircle)
+                {
+                    acceleration += GravitationalAcceleration(circle.m_Position, otherCircle.m_Position, otherCircle.m_Mass);
+                }
+            },
+            [&circle, &acceleration](const CircleMassAggregate& aggregate)
+            {
+                acceleration += GravitationalAcceleration(circle.m_Position, aggregate.m_CentreOfMass, aggregate.m_Mass);
+            });
+    }
+
+    for(size_t i{0}; i != circles.size(); ++i)
+    {
+        circles[i].m_Velocity += accelerations[i] * delta;
+    }
+}
+
+void ApplyGravityBruteForce(std::vector<Circle>& circles, const float_t delta)
+{
+    std::vector<glm::vec2> accelerations(circles.size());
+    for(size_t i{0}; i != circles.size(); ++i)
+    {
+        for(size_t j{i + 1}; j < circles.size(); ++j)
+        {
+            accelerations[i] += GravitationalAcceleration(circles[i].m_Position, circles[j].m_Position, circles[j].m_Mass);
+            accelerations[j] += GravitationalAcceleration(circles[j].m_Position, circles[i].m_Position, circles[i].m_Mass);
+        }
+    }
+
+    for(size_t i{0}; i != circles.size(); ++i)
+    {
+        circles[i].m_Velocity += accelerations[i] * delta;
+    }
+}
+
+Circle* RaycastCircles(
+    const Quadtree& quadtree, const glm::vec2& origin, const glm::vec2& direction, const float_t maxDistance, float_t& hitDistance)
+{
+    const glm::vec2 normalizedDirection{glm::normalize(direction)};
+    Circle* closestCircle{nullptr};
+    float_t closestDistance{maxDistance};
+
+    // Circles are stored by their centre, so pad Branches by MAX_RADIUS to find every circle overlapping the ray.
+    quadtree.Raycast(origin, normalizedDirection, maxDistance, MAX_RADIUS, [&](Circle& circle, const float_t entryDistance)
+    {
+        // Branches are visited front to back, every remaining circle is at least entryDistance along the ray.
+        if(closestCircle && entryDistance > closestDistance)
+        {
+            return false;
+        }
+
+        float_t distance{0.0f};
+        if(IntersectRayCircle(origin, normalizedDirection, closestDistance, circle, distance))
+        {
+            closestCircle = &circle;
+            closestDistance = distance;
+        }
+        return true;
+    });
+
+    hitDistance = closestDistance;
+    return closestCircle;
+}
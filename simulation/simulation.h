@@ -1,9 +1,18 @@
 #pragma once
 
 #include "quadtree.h"
+#include "sweepandprune.h"
 
 void UpdateCirclesQuadtreeFoundLeaves(std::vector<Circle>& circles, Quadtree& quadtree, float_t delta);
 void UpdateCirclesQuadtreeFoundBranches(std::vector<Circle>& circles, Quadtree& quadtree, float_t delta);
 void UpdateCirclesQuadtreeInnerLoop(Quadtree& quadtree, const Quadtree::Branch& branch, float_t delta);
+void UpdateCirclesQuadtreeSwept(std::vector<Circle>& circles, Quadtree& quadtree, float_t delta);
+void UpdateCirclesLayeredQuadtree(std::vector<Circle>& dynamicCircles, const LayeredQuadtree& quadtree, float_t delta);
 
+void UpdateCirclesSweepAndPrune(std::vector<Circle>& circles, SweepAndPrune& sweepAndPrune, float_t delta);
 void UpdateCirclesBruteForce(std::vector<Circle>& circles, float_t delta);
+
+void ApplyGravityQuadtree(std::vector<Circle>& circles, const MassQuadtree& quadtree, float_t openingAngle, float_t delta);
+void ApplyGravityBruteForce(std::vector<Circle>& circles, float_t delta);
+
+Circle* RaycastCircles(const Quadtree& quadtree, const glm::vec2& origin, const glm::vec2& direction, float_t maxDistance, float_t& hitDistance);
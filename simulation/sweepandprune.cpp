@@ -0,0 +1,48 @@
+#include "stdafx.h"
+#include "sweepandprune.h"
+
+#include <algorithm>
+
+void SweepAndPrune::Update(const std::vector<Circle>& circles)
+{
+    // Entries that survive from the last update keep their sorted order. Circles added since are appended and
+    // merged in, removing circles invalidates the indices so everything is sorted again.
+    size_t sortedSize{m_Entries.size()};
+    if(circles.size() < m_Entries.size())
+    {
+        sortedSize = 0;
+        m_Entries.clear();
+    }
+
+    m_Entries.reserve(circles.size());
+    for(uint32_t i{static_cast<uint32_t>(m_Entries.size())}; i != circles.size(); ++i)
+    {
+        m_Entries.push_back(Entry{0.0f, i});
+    }
+
+    for(Entry& entry : m_Entries)
+    {
+        const Circle& circle{circles[entry.m_Index]};
+        entry.m_MinX = circle.m_Position.x - circle.m_Radius;
+    }
+
+    // Insertion sort is close to linear when circles have only moved a little since the last update.
+    for(size_t i{1}; i < sortedSize; ++i)
+    {
+        const Entry entry{m_Entries[i]};
+        size_t j{i};
+        for(; j != 0 && m_Entries[j - 1].m_MinX > entry.m_MinX; --j)
+        {
+            m_Entries[j] = m_Entries[j - 1];
+        }
+        m_Entries[j] = entry;
+    }
+
+    if(sortedSize != m_Entries.size())
+    {
+        const auto firstNewEntry{std::begin(m_Entries) + static_cast<std::ptrdiff_t>(sortedSize)};
+        std::sort(firstNewEntry, std::end(m_Entries), [](const Entry& lhs, const Entry& rhs) { return lhs.m_MinX < rhs.m_MinX; });
+        std::inplace_merge(std::begin(m_Entries), firstNewEntry, std::end(m_Entries),
+            [](const Entry& lhs, const Entry& rhs) { return lhs.m_MinX < rhs.m_MinX; });
+    }
+}
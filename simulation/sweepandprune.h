@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include "shapeprimitives.h"
+
+// Sort and sweep broad phase along the x axis. The sorted order is kept between updates and re-sorted with an
+// insertion sort, which is close to linear when circles have only moved a little since the last update.
+class SweepAndPrune
+{
+public:
+    void Update(const std::vector<Circle>& circles);
+    template<class TVisitor>
+    void VisitOverlappingPairs(std::vector<Circle>& circles, TVisitor&& visitor) const;
+private:
+    struct Entry
+    {
+        float_t m_MinX{0.0f};
+        uint32_t m_Index{0};
+    };
+
+    std::vector<Entry> m_Entries{};
+};
+
+// Calls visitor(circleA, circleB) once for each pair of circles whose bounding boxes overlap. Update must have
+// been called since the circles last moved.
+template<class TVisitor>
+void SweepAndPrune::VisitOverlappingPairs(std::vector<Circle>& circles, TVisitor&& visitor) const
+{
+    assert(m_Entries.size() == circles.size());
+
+    const size_t size{m_Entries.size()};
+    for(size_t i{0}; i != size; ++i)
+    {
+        Circle& circle{circles[m_Entries[i].m_Index]};
+        const float_t maxX{circle.m_Position.x + circle.m_Radius};
+
+        for(size_t j{i + 1}; j != size && m_Entries[j].m_MinX <= maxX; ++j)
+        {
+            Circle& otherCircle{circles[m_Entries[j].m_Index]};
+            if(glm::abs(circle.m_Position.y - otherCircle.m_Position.y) <= circle.m_Radius + otherCircle.m_Radius)
+            {
+                visitor(circle, otherCircle);
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+TEST_CASE("Compact Quadtree - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    CompactQuadtree compactQuadtree{};
+    compactQuadtree.Build(quadtree, circles);
+
+    INFO("Quadtree: " << QuadtreeMemoryUsage(quadtree) << " bytes, " << sizeof(Quadtree::Branch) << " bytes per Branch");
+    INFO("Compact Quadtree: " << compactQuadtree.GetMemoryUsage() << " bytes, " << sizeof(CompactQuadtreeBranch) << " bytes per Branch, "
+        << compactQuadtree.GetNumBranches() << " Branches");
+    REQUIRE(compactQuadtree.GetMemoryUsage() < QuadtreeMemoryUsage(quadtree));
+
+    for(uint32_t i{0}; i != 100; ++i)
+    {
+        const float_t widthHeight{Random::RandomInRange(10.0f, 200.0f)};
+        const Rectangle rect{RandomWindowPosition(), widthHeight, widthHeight};
+
+        std::vector<Circle*> expectedLeaves{};
+        quadtree.FindLeaves(rect, expectedLeaves);
+        std::vector<Circle*> foundLeaves{};
+        compactQuadtree.FindLeaves(rect, foundLeaves);
+        REQUIRE(foundLeaves == expectedLeaves);
+    }
+}
+
+TEST_CASE("Compact Quadtree - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    CompactQuadtree compactQuadtree{};
+    compactQuadtree.Build(quadtree, circles);
+
+    const auto queryAll = [&circles](const auto& queriedQuadtree)
+    {
+        size_t found{0};
+        std::vector<Circle*> foundLeaves{};
+        for(const Circle& circle : circles)
+        {
+            foundLeaves.clear();
+            const float_t widthHeight{circle.m_Radius * 2.0f};
+            const Rectangle circleAprox{circle.m_Position - glm::vec2{circle.m_Radius, circle.m_Radius}, widthHeight, widthHeight};
+            queriedQuadtree.FindLeaves(circleAprox, foundLeaves);
+            found += foundLeaves.size();
+        }
+        return found;
+    };
+
+    // Not like for like, Quadtree::FindLeaves walks every Branch while the CompactQuadtree skips Branches
+    // outside the query, so the difference is pruning as well as Branch size.
+    BENCHMARK("Quadtree Find Leaves Unpruned")
+    {
+        return queryAll(quadtree);
+    };
+
+    BENCHMARK("Compact Quadtree Find Leaves Pruned")
+    {
+        return queryAll(compactQuadtree);
+    };
+
+    BENCHMARK("Compact Quadtree Build")
+    {
+        compactQuadtree.Build(quadtree, circles);
+    };
+}
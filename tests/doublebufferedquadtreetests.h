@@ -0,0 +1,92 @@
+#pragma once
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+TEST_CASE("Double Buffered Quadtree - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    DoubleBufferedQuadtree doubleBufferedQuadtree{};
+    REQUIRE_FALSE(doubleBufferedQuadtree.Swap());
+
+    doubleBufferedQuadtree.BeginRebuild(circles);
+    REQUIRE(doubleBufferedQuadtree.IsRebuilding());
+
+    // Moving the source Leaves must not affect the snapshot being built.
+    const std::vector<Circle> snapshot{circles};
+    for(Circle& circle : circles)
+    {
+        circle.m_Position += circle.m_Velocity * DELTA;
+    }
+
+    REQUIRE(doubleBufferedQuadtree.Swap());
+    REQUIRE_FALSE(doubleBufferedQuadtree.IsRebuilding());
+    REQUIRE(doubleBufferedQuadtree.GetLeaves().size() == snapshot.size());
+
+    std::vector<Circle> expectedCircles{snapshot};
+    Quadtree expectedQuadtree{};
+    RebuildQuadtree(expectedQuadtree, expectedCircles);
+
+    const Rectangle rect{glm::vec2{100.0f, 100.0f}, 300.0f, 300.0f};
+    std::vector<Circle*> foundLeaves{};
+    std::vector<Circle*> expectedLeaves{};
+    doubleBufferedQuadtree.GetQuadtree().FindLeaves(rect, foundLeaves);
+    expectedQuadtree.FindLeaves(rect, expectedLeaves);
+
+    REQUIRE(foundLeaves.size() == expectedLeaves.size());
+    for(size_t i{0}; i != foundLeaves.size(); ++i)
+    {
+        REQUIRE(foundLeaves[i]->m_Position == expectedLeaves[i]->m_Position);
+    }
+}
+
+TEST_CASE("Double Buffered Quadtree - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    const auto queryAll = [&circles](const Quadtree& quadtree)
+    {
+        size_t found{0};
+        std::vector<Circle*> foundLeaves{};
+        for(const Circle& circle : circles)
+        {
+            foundLeaves.clear();
+            const float_t widthHeight{circle.m_Radius * 2.0f};
+            const Rectangle circleAprox{circle.m_Position - glm::vec2{circle.m_Radius, circle.m_Radius}, widthHeight, widthHeight};
+            quadtree.FindLeaves(circleAprox, foundLeaves);
+            found += foundLeaves.size();
+        }
+        return found;
+    };
+
+    Quadtree quadtree{};
+    BENCHMARK("Serial Rebuild Then Query")
+    {
+        RebuildQuadtree(quadtree, circles);
+        return queryAll(quadtree);
+    };
+
+    DoubleBufferedQuadtree doubleBufferedQuadtree{};
+    doubleBufferedQuadtree.BeginRebuild(circles);
+    BENCHMARK("Double Buffered Rebuild While Querying")
+    {
+        doubleBufferedQuadtree.Swap();
+        doubleBufferedQuadtree.BeginRebuild(circles);
+        return queryAll(doubleBufferedQuadtree.GetQuadtree());
+    };
+    doubleBufferedQuadtree.Swap();
+}
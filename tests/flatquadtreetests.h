@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/mappedfile.h"
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+TEST_CASE("Flat Quadtree - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+
+    const std::filesystem::path path{std::filesystem::temp_directory_path() / "flatquadtreetests.bin"};
+    REQUIRE(SaveFlatQuadtree(SerialiseQuadtree(quadtree, circles), path));
+
+    {
+        MappedFile mappedFile{};
+        REQUIRE(mappedFile.Open(path));
+
+        FlatQuadtree flatQuadtree{};
+        REQUIRE(flatQuadtree.Load(mappedFile.GetData()));
+        REQUIRE(flatQuadtree.GetLeaves().size() == circles.size());
+        REQUIRE(flatQuadtree.GetNumSourceLeaves() == circles.size());
+
+        for(uint32_t i{0}; i != 100; ++i)
+        {
+            const float_t widthHeight{Random::RandomInRange(10.0f, 200.0f)};
+            const Rectangle rect{RandomWindowPosition(), widthHeight, widthHeight};
+
+            std::vector<Circle*> expectedLeaves{};
+            std::vector<uint32_t> foundLeaves{};
+            REQUIRE(quadtree.FindLeaves(rect, expectedLeaves) == flatQuadtree.FindLeaves(rect, foundLeaves));
+            REQUIRE(std::ranges::equal(foundLeaves, expectedLeaves, {}, {}, [&circles](const Circle* const circle)
+            {
+                return static_cast<uint32_t>(circle - circles.data());
+            }));
+
+            const FlatQuadtreeBranch* const flatBranch{flatQuadtree.FindBranch(rect.GetTopLeft())};
+            const Quadtree::Branch* const branch{quadtree.FindBranch(rect.GetTopLeft())};
+            REQUIRE(flatBranch);
+            REQUIRE(branch);
+            REQUIRE(flatBranch->m_NumLeaves == branch->GetLeaves().size());
+        }
+    }
+
+    SECTION("Rejects Invalid Data")
+    {
+        std::vector<std::byte> data{SerialiseQuadtree(quadtree, circles)};
+        FlatQuadtree flatQuadtree{};
+        REQUIRE_FALSE(flatQuadtree.Load(std::span{data}.first(data.size() - 1)));
+        data[0] = std::byte{0};
+        REQUIRE_FALSE(flatQuadtree.Load(data));
+    }
+
+    SECTION("Rejects Invalid Branch Ranges")
+    {
+        const std::vector<std::byte> data{SerialiseQuadtree(quadtree, circles)};
+        FlatQuadtreeHeader header{};
+        std::memcpy(&header, data.data(), sizeof(FlatQuadtreeHeader));
+
+        const auto loadCorrupted = [&data, &header](const auto& corrupt)
+        {
+            std::vector<std::byte> corruptedData{data};
+            const std::span<FlatQuadtreeBranch> branches{
+                reinterpret_cast<FlatQuadtreeBranch*>(corruptedData.data() + sizeof(FlatQuadtreeHeader)), header.m_NumBranches};
+            const std::span<uint32_t> leaves{
+                reinterpret_cast<uint32_t*>(corruptedData.data() + sizeof(FlatQuadtreeHeader) + branches.size_bytes()), header.m_NumLeaves};
+            corrupt(branches, leaves);
+
+            FlatQuadtree flatQuadtree{};
+            return flatQuadtree.Load(corruptedData);
+        };
+
+        // The first two Branches with children.
+        const std::span<const FlatQuadtreeBranch> branches{
+            reinterpret_cast<const FlatQuadtreeBranch*>(data.data() + sizeof(FlatQuadtreeHeader)), header.m_NumBranches};
+        const auto firstParent{std::ranges::find_if(branches, &FlatQuadtreeBranch::HasBranches)};
+        const auto secondParent{std::ranges::find_if(firstParent + 1, std::end(branches), &FlatQuadtreeBranch::HasBranches)};
+        REQUIRE(secondParent != std::end(branches));
+        const size_t firstParentIndex{static_cast<size_t>(firstParent - std::begin(branches))};
+        const size_t secondParentIndex{static_cast<size_t>(secondParent - std::begin(branches))};
+
+        REQUIRE(loadCorrupted([](std::span<FlatQuadtreeBranch>, std::span<uint32_t>) {}));
+        // The root as its own child would recurse forever.
+        REQUIRE_FALSE(loadCorrupted([](std::span<FlatQuadtreeBranch> branches, std::span<uint32_t>) { branches[0].m_FirstBranch = 0; }));
+        REQUIRE_FALSE(loadCorrupted([](std::span<FlatQuadtreeBranch> branches, std::span<uint32_t>) { branches[0].m_FirstBranch = UINT32_MAX; }));
+        REQUIRE_FALSE(loadCorrupted([](std::span<FlatQuadtreeBranch> branches, std::span<uint32_t>) { branches[0].m_NumLeaves = UINT32_MAX; }));
+        // Branches sharing children would be visited once per parent.
+        REQUIRE_FALSE(loadCorrupted([=](std::span<FlatQuadtreeBranch> branches, std::span<uint32_t>)
+        {
+            branches[secondParentIndex].m_FirstBranch = branches[firstParentIndex].m_FirstBranch;
+        }));
+        // Overlapping Leaf ranges.
+        REQUIRE_FALSE(loadCorrupted([](std::span<FlatQuadtreeBranch> branches, std::span<uint32_t>)
+        {
+            const auto leafBranch{std::ranges::find_if(branches, [](const FlatQuadtreeBranch& branch) { return branch.m_NumLeaves != 0; })};
+            ++leafBranch->m_NumLeaves;
+        }));
+        REQUIRE_FALSE(loadCorrupted([&circles](std::span<FlatQuadtreeBranch>, std::span<uint32_t> leaves)
+        {
+            leaves.back() = static_cast<uint32_t>(circles.size());
+        }));
+    }
+
+    SECTION("Rejects Misaligned Data")
+    {
+        const std::vector<std::byte> data{SerialiseQuadtree(quadtree, circles)};
+        std::vector<std::byte> misalignedData(data.size() + 1);
+        std::ranges::copy(data, std::begin(misalignedData) + 1);
+
+        FlatQuadtree flatQuadtree{};
+        REQUIRE_FALSE(flatQuadtree.Load(std::span{misalignedData}.subspan(1)));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Flat Quadtree - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    const std::filesystem::path path{std::filesystem::temp_directory_path() / "flatquadtreebenchmarks.bin"};
+    SaveFlatQuadtree(SerialiseQuadtree(quadtree, circles), path);
+
+    BENCHMARK("Rebuild")
+    {
+        Quadtree rebuiltQuadtree{};
+        RebuildQuadtree(rebuiltQuadtree, circles);
+        return rebuiltQuadtree.GetRootBranch().HasBranches();
+    };
+
+    BENCHMARK("Map And Load")
+    {
+        MappedFile mappedFile{};
+        mappedFile.Open(path);
+        FlatQuadtree flatQuadtree{};
+        return flatQuadtree.Load(mappedFile.GetData());
+    };
+
+    MappedFile mappedFile{};
+    mappedFile.Open(path);
+    FlatQuadtree flatQuadtree{};
+    flatQuadtree.Load(mappedFile.GetData());
+
+    BENCHMARK("Search Quadtree")
+    {
+        size_t found{0};
+        std::vector<Circle*> foundLeaves{};
+        for(const Circle& circle : circles)
+        {
+            foundLeaves.clear();
+            const float_t widthHeight{circle.m_Radius * 2.0f};
+            quadtree.FindLeaves(Rectangle{circle.m_Position - glm::vec2{circle.m_Radius, circle.m_Radius}, widthHeight, widthHeight}, foundLeaves);
+            found += foundLeaves.size();
+        }
+        return found;
+    };
+
+    BENCHMARK("Search Flat Quadtree")
+    {
+        size_t found{0};
+        std::vector<uint32_t> foundLeaves{};
+        for(const Circle& circle : circles)
+        {
+            foundLeaves.clear();
+            const float_t widthHeight{circle.m_Radius * 2.0f};
+            flatQuadtree.FindLeaves(Rectangle{circle.m_Position - glm::vec2{circle.m_Radius, circle.m_Radius}, widthHeight, widthHeight}, foundLeaves);
+            found += foundLeaves.size();
+        }
+        return found;
+    };
+
+    mappedFile.Close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <set>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+namespace
+{
+    // Most Leaves in a world never move.
+    inline constexpr uint32_t NUM_STATIC_CIRCLES{NUM_CIRCLES * 4 / 5};
+    inline constexpr uint32_t NUM_DYNAMIC_CIRCLES{NUM_CIRCLES - NUM_STATIC_CIRCLES};
+
+    std::vector<Circle> SpawnCircles(const uint32_t count)
+    {
+        std::vector<Circle> circles{};
+        circles.reserve(count);
+        for(uint32_t i{0}; i != count; ++i)
+        {
+            circles.push_back(SpawnCircle(RandomWindowPosition()));
+        }
+        return circles;
+    }
+
+    bool CirclesOverlap(const Circle& circleA, const Circle& circleB)
+    {
+        return glm::length(circleB.m_Position - circleA.m_Position) < circleA.m_Radius + circleB.m_Radius;
+    }
+}
+
+TEST_CASE("Layered Quadtree - Unit Tests")
+{
+    std::vector<Circle> staticCircles{SpawnCircles(NUM_STATIC_CIRCLES)};
+    std::vector<Circle> dynamicCircles{SpawnCircles(NUM_DYNAMIC_CIRCLES)};
+
+    LayeredQuadtree layeredQuadtree{};
+    const std::vector<Circle> unorderedStaticCircles{staticCircles};
+    const std::vector<uint32_t> newIndices{layeredQuadtree.RebuildStatic(staticCircles)};
+    for(uint32_t oldIndex{0}; oldIndex != newIndices.size(); ++oldIndex)
+    {
+        REQUIRE(staticCircles[newIndices[oldIndex]].m_Position == unorderedStaticCircles[oldIndex].m_Position);
+    }
+    layeredQuadtree.RebuildDynamic(dynamicCircles);
+
+    SECTION("Queries Span Both Tiers")
+    {
+        const Rectangle rect{glm::vec2{100.0f, 100.0f}, 300.0f, 300.0f};
+        std::vector<Circle*> foundLeaves{};
+        layeredQuadtree.FindLeaves(rect, foundLeaves);
+
+        std::vector<Circle*> expectedLeaves{};
+        layeredQuadtree.GetStaticQuadtree().FindLeaves(rect, expectedLeaves);
+        std::vector<Circle*> expectedDynamicLeaves{};
+        layeredQuadtree.GetDynamicQuadtree().FindLeaves(rect, expectedDynamicLeaves);
+        expectedLeaves.insert(std::end(expectedLeaves), std::begin(expectedDynamicLeaves), std::end(expectedDynamicLeaves));
+        REQUIRE(foundLeaves == expectedLeaves);
+
+        std::vector<const Quadtree::Branch*> foundBranches{};
+        layeredQuadtree.FindBranches(rect, foundBranches);
+        std::vector<const Quadtree::Branch*> expectedBranches{};
+        layeredQuadtree.GetStaticQuadtree().FindBranches(rect, expectedBranches);
+        std::vector<const Quadtree::Branch*> expectedDynamicBranches{};
+        layeredQuadtree.GetDynamicQuadtree().FindBranches(rect, expectedDynamicBranches);
+        expectedBranches.insert(std::end(expectedBranches), std::begin(expectedDynamicBranches), std::end(expectedDynamicBranches));
+        REQUIRE(foundBranches == expectedBranches);
+    }
+
+    SECTION("Pairs")
+    {
+        const auto getBounds = [](const Circle& circle)
+        {
+            const float_t halfWidthHeight{circle.m_Radius + MAX_RADIUS};
+            return Rectangle{circle.m_Position - glm::vec2{halfWidthHeight, halfWidthHeight}, halfWidthHeight * 2.0f, halfWidthHeight * 2.0f};
+        };
+        const auto isDynamic = [&dynamicCircles](const Circle& circle)
+        {
+            return &circle >= dynamicCircles.data() && &circle < dynamicCircles.data() + dynamicCircles.size();
+        };
+
+        std::set<std::pair<const Circle*, const Circle*>> dynamicPairs{};
+        std::set<std::pair<const Circle*, const Circle*>> staticPairs{};
+        bool duplicatePair{false};
+        bool wrongTier{false};
+        layeredQuadtree.VisitPairs(getBounds,
+            [&](Circle& circle, Circle& otherCircle)
+            {
+                wrongTier |= !isDynamic(circle) || !isDynamic(otherCircle);
+                duplicatePair |= !dynamicPairs.emplace(std::min(&circle, &otherCircle), std::max(&circle, &otherCircle)).second;
+            },
+            [&](Circle& circle, const Circle& staticCircle)
+            {
+                wrongTier |= !isDynamic(circle) || isDynamic(staticCircle);
+                duplicatePair |= !staticPairs.emplace(&circle, &staticCircle).second;
+            });
+        REQUIRE_FALSE(wrongTier);
+        REQUIRE_FALSE(duplicatePair);
+
+        // Every overlapping pair must be reported.
+        for(size_t i{0}; i != dynamicCircles.size(); ++i)
+        {
+            for(size_t j{i + 1}; j != dynamicCircles.size(); ++j)
+            {
+                if(CirclesOverlap(dynamicCircles[i], dynamicCircles[j]))
+                {
+                    REQUIRE(dynamicPairs.contains({&dynamicCircles[i], &dynamicCircles[j]}));
+                }
+            }
+
+            for(const Circle& staticCircle : staticCircles)
+            {
+                if(CirclesOverlap(dynamicCircles[i], staticCircle))
+                {
+                    REQUIRE(staticPairs.contains({&dynamicCircles[i], &staticCircle}));
+                }
+            }
+        }
+    }
+
+    SECTION("Static Circles Do Not Move")
+    {
+        const std::vector<Circle> expectedStaticCircles{staticCircles};
+        UpdateCirclesLayeredQuadtree(dynamicCircles, layeredQuadtree, DELTA);
+        for(size_t i{0}; i != staticCircles.size(); ++i)
+        {
+            REQUIRE(staticCircles[i].m_Position == expectedStaticCircles[i].m_Position);
+            REQUIRE(staticCircles[i].m_Velocity == expectedStaticCircles[i].m_Velocity);
+        }
+    }
+}
+
+TEST_CASE("Layered Quadtree - Benchmarks")
+{
+    std::vector<Circle> staticCircles{SpawnCircles(NUM_STATIC_CIRCLES)};
+    std::vector<Circle> dynamicCircles{SpawnCircles(NUM_DYNAMIC_CIRCLES)};
+
+    std::vector<Circle> allCircles{staticCircles};
+    allCircles.insert(std::end(allCircles), std::begin(dynamicCircles), std::end(dynamicCircles));
+    Quadtree quadtree{};
+    BENCHMARK("Rebuild All Leaves")
+    {
+        RebuildQuadtree(quadtree, allCircles);
+    };
+
+    LayeredQuadtree layeredQuadtree{};
+    layeredQuadtree.RebuildStatic(staticCircles);
+    BENCHMARK("Rebuild Dynamic Leaves")
+    {
+        layeredQuadtree.RebuildDynamic(dynamicCircles);
+    };
+
+    BENCHMARK("Rebuild Dynamic Leaves And Update")
+    {
+        for(Circle& circle : dynamicCircles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        layeredQuadtree.RebuildDynamic(dynamicCircles);
+        UpdateCirclesLayeredQuadtree(dynamicCircles, layeredQuadtree, DELTA);
+    };
+}
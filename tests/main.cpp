@@ -2,7 +2,13 @@
 
 #include <catch2/catch_session.hpp>
 
+#include "compactquadtreetests.h"
+#include "doublebufferedquadtreetests.h"
+#include "flatquadtreetests.h"
+#include "layeredquadtreetests.h"
+#include "quadtreesubscriptionstests.h"
 #include "quadtreetests.h"
+#include "quadtreeviewtests.h"
 
 int main(const int argc, const char* const argv[])
 {
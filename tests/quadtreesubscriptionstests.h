@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+namespace
+{
+    inline constexpr uint32_t NUM_SUBSCRIPTIONS{64};
+    inline constexpr float_t SUBSCRIPTION_SIZE{200.0f};
+
+    Rectangle RandomSubscriptionRegion()
+    {
+        return Rectangle{RandomWindowPosition(), SUBSCRIPTION_SIZE, SUBSCRIPTION_SIZE};
+    }
+
+    void MoveCircles(std::vector<Circle>& circles)
+    {
+        for(Circle& circle : circles)
+        {
+            circle.m_Position += circle.m_Velocity * DELTA;
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+    }
+}
+
+TEST_CASE("Quadtree Subscriptions - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    std::vector<Rectangle> regions{};
+    QuadtreeSubscriptions subscriptions{};
+    for(uint32_t i{0}; i != NUM_SUBSCRIPTIONS; ++i)
+    {
+        regions.push_back(RandomSubscriptionRegion());
+        REQUIRE(subscriptions.Subscribe(regions.back()) == i);
+    }
+
+    // Brute force membership, every (subscription, leaf index) pair inside a region.
+    std::set<std::pair<uint32_t, uint32_t>> expectedMembership{};
+    const auto findExpectedMembership = [&circles, &regions](const std::vector<bool>& active)
+    {
+        std::set<std::pair<uint32_t, uint32_t>> membership{};
+        for(uint32_t subscription{0}; subscription != regions.size(); ++subscription)
+        {
+            if(!active[subscription])
+                continue;
+
+            for(uint32_t leafIndex{0}; leafIndex != circles.size(); ++leafIndex)
+            {
+                if(CollisionRectPoint(regions[subscription], circles[leafIndex].m_Position))
+                {
+                    membership.emplace(subscription, leafIndex);
+                }
+            }
+        }
+        return membership;
+    };
+
+    std::vector<bool> active(NUM_SUBSCRIPTIONS, true);
+    Quadtree quadtree{};
+    for(uint32_t frame{0}; frame != 20; ++frame)
+    {
+        if(frame == 10)
+        {
+            subscriptions.Unsubscribe(0);
+            active[0] = false;
+        }
+        if(frame % 5 == 4)
+        {
+            regions[1] = RandomSubscriptionRegion();
+            subscriptions.SetRegion(1, regions[1]);
+        }
+
+        RebuildQuadtree(quadtree, circles);
+        std::set<std::pair<uint32_t, uint32_t>> membership{expectedMembership};
+        bool duplicateEvent{false};
+        subscriptions.Update(quadtree, circles,
+            [&membership, &duplicateEvent](const uint32_t subscription, const uint32_t leafIndex)
+            {
+                duplicateEvent |= !membership.emplace(subscription, leafIndex).second;
+            },
+            [&membership, &duplicateEvent](const uint32_t subscription, const uint32_t leafIndex)
+            {
+                duplicateEvent |= membership.erase({subscription, leafIndex}) == 0;
+            });
+
+        expectedMembership = findExpectedMembership(active);
+        REQUIRE_FALSE(duplicateEvent);
+        REQUIRE(membership == expectedMembership);
+
+        for(uint32_t leafIndex{0}; leafIndex != circles.size(); ++leafIndex)
+        {
+            const std::vector<uint32_t>& leafSubscriptions{subscriptions.GetSubscriptions(leafIndex)};
+            REQUIRE(std::ranges::all_of(leafSubscriptions, [&expectedMembership, leafIndex](const uint32_t subscription)
+            {
+                return expectedMembership.contains({subscription, leafIndex});
+            }));
+        }
+
+        MoveCircles(circles);
+    }
+
+    size_t events{0};
+    const auto countEvent = [&events](const uint32_t, const uint32_t) { ++events; };
+    RebuildQuadtree(quadtree, circles);
+    subscriptions.Update(quadtree, circles, countEvent, countEvent);
+
+    // Reordered Leaves have not moved, once remapped they neither leave nor enter a region.
+    const std::vector<uint32_t> newIndices{ReorderLeaves(quadtree, circles)};
+    subscriptions.RemapLeaves(newIndices);
+    events = 0;
+    subscriptions.Update(quadtree, circles, countEvent, countEvent);
+    REQUIRE(events == 0);
+
+    // Removed Leaves leave every region they were inside.
+    std::set<std::pair<uint32_t, uint32_t>> membership{findExpectedMembership(active)};
+    circles.erase(std::begin(circles) + circles.size() / 2, std::end(circles));
+    RebuildQuadtree(quadtree, circles);
+    bool duplicateEvent{false};
+    subscriptions.Update(quadtree, circles,
+        [&membership, &duplicateEvent](const uint32_t subscription, const uint32_t leafIndex)
+        {
+            duplicateEvent |= !membership.emplace(subscription, leafIndex).second;
+        },
+        [&membership, &duplicateEvent](const uint32_t subscription, const uint32_t leafIndex)
+        {
+            duplicateEvent |= membership.erase({subscription, leafIndex}) == 0;
+        });
+    REQUIRE_FALSE(duplicateEvent);
+    REQUIRE(membership == findExpectedMembership(active));
+}
+
+TEST_CASE("Quadtree Subscriptions - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    std::vector<Rectangle> regions{};
+    for(uint32_t i{0}; i != NUM_SUBSCRIPTIONS; ++i)
+    {
+        regions.push_back(RandomSubscriptionRegion());
+    }
+
+    Quadtree quadtree{};
+
+    // Query every region each frame and diff the sorted results against the previous frame.
+    std::vector<std::vector<Circle*>> previousLeaves(NUM_SUBSCRIPTIONS);
+    std::vector<Circle*> foundLeaves{};
+    std::vector<Circle*> changedLeaves{};
+    BENCHMARK("Find Leaves And Diff")
+    {
+        MoveCircles(circles);
+        RebuildQuadtree(quadtree, circles);
+
+        size_t events{0};
+        for(uint32_t subscription{0}; subscription != NUM_SUBSCRIPTIONS; ++subscription)
+        {
+            foundLeaves.clear();
+            quadtree.FindLeaves(regions[subscription], foundLeaves);
+            std::erase_if(foundLeaves, [&regions, subscription](const Circle* const circle)
+            {
+                return !CollisionRectPoint(regions[subscription], circle->m_Position);
+            });
+            std::ranges::sort(foundLeaves);
+
+            std::vector<Circle*>& previous{previousLeaves[subscription]};
+            changedLeaves.clear();
+            std::ranges::set_symmetric_difference(previous, foundLeaves, std::back_inserter(changedLeaves));
+            events += changedLeaves.size();
+            previous.swap(foundLeaves);
+        }
+        return events;
+    };
+
+    QuadtreeSubscriptions subscriptions{};
+    for(const Rectangle& region : regions)
+    {
+        subscriptions.Subscribe(region);
+    }
+    BENCHMARK("Subscriptions")
+    {
+        MoveCircles(circles);
+        RebuildQuadtree(quadtree, circles);
+
+        size_t events{0};
+        subscriptions.Update(quadtree, circles,
+            [&events](const uint32_t, const uint32_t) { ++events; },
+            [&events](const uint32_t, const uint32_t) { ++events; });
+        return events;
+    };
+}
@@ -1,17 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <memory_resource>
+
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "simulation/simulation.h"
 #include "simulation/quadtree.h"
 
-namespace
-{
-    inline constexpr uint32_t NUM_CIRCLES{5000};
-    inline constexpr float_t DELTA{0.1f};
-}
-
 TEST_CASE("Build Quadtree - Benchmarks")
 {
     std::vector<Circle> circles{};
@@ -26,6 +23,72 @@ TEST_CASE("Build Quadtree - Benchmarks")
         Quadtree quadtree{};
         RebuildQuadtree(quadtree, circles);
     };
+
+    // A fixed buffer so release() only rewinds, running out throws rather than falling back to the heap.
+    std::vector<std::byte> frameArenaBuffer(FRAME_ARENA_SIZE);
+    std::pmr::monotonic_buffer_resource frameArena{frameArenaBuffer.data(), frameArenaBuffer.size(), std::pmr::null_memory_resource()};
+    BENCHMARK("Monotonic Arena")
+    {
+        {
+            Quadtree quadtree{&frameArena};
+            RebuildQuadtree(quadtree, circles);
+        }
+        frameArena.release();
+    };
+}
+
+TEST_CASE("Memory Resource - Unit Tests")
+{
+    // Counts allocations passed through to the default resource.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        uint32_t m_Allocations{0};
+        uint32_t m_Deallocations{0};
+    private:
+        void* do_allocate(const size_t bytes, const size_t alignment) override
+        {
+            ++m_Allocations;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* const p, const size_t bytes, const size_t alignment) override
+        {
+            ++m_Deallocations;
+            std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    CountingResource resource{};
+    {
+        Quadtree quadtree{&resource};
+        REQUIRE(quadtree.GetMemoryResource() == &resource);
+        RebuildQuadtree(quadtree, circles);
+        REQUIRE(resource.m_Allocations > 0);
+
+        std::pmr::vector<Circle*> foundLeaves{&resource};
+        const uint32_t allocations{resource.m_Allocations};
+        REQUIRE(quadtree.FindLeaves(quadtree.GetRootBranch().GetRect(), foundLeaves));
+        REQUIRE(foundLeaves.size() == circles.size());
+        REQUIRE(resource.m_Allocations > allocations);
+
+        // Reset hands every allocation back so the resource can be released.
+        foundLeaves = std::pmr::vector<Circle*>{&resource};
+        quadtree.Reset();
+        REQUIRE(resource.m_Allocations == resource.m_Deallocations);
+    }
 }
 
 TEST_CASE("Search Quadtree - Benchmarks")
@@ -59,6 +122,23 @@ TEST_CASE("Search Quadtree - Benchmarks")
         UpdateCirclesQuadtreeFoundLeaves(circles, quadtree, DELTA);
     };
 
+    // A fixed buffer so release() only rewinds, running out throws rather than falling back to the heap.
+    std::vector<std::byte> frameArenaBuffer(FRAME_ARENA_SIZE);
+    std::pmr::monotonic_buffer_resource frameArena{frameArenaBuffer.data(), frameArenaBuffer.size(), std::pmr::null_memory_resource()};
+    BENCHMARK("Found Leaves Monotonic Arena")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        {
+            Quadtree arenaQuadtree{&frameArena};
+            RebuildQuadtree(arenaQuadtree, circles);
+            UpdateCirclesQuadtreeFoundLeaves(circles, arenaQuadtree, DELTA);
+        }
+        frameArena.release();
+    };
+
     BENCHMARK("Inner Loop")
     {
         for(Circle& circle : circles)
@@ -68,6 +148,558 @@ TEST_CASE("Search Quadtree - Benchmarks")
         RebuildQuadtree(quadtree, circles);
         UpdateCirclesQuadtreeInnerLoop(quadtree, quadtree.GetRootBranch(), DELTA);
     };
+
+    BENCHMARK("Swept")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeSwept(circles, quadtree, DELTA);
+    };
+}
+
+TEST_CASE("Swept Collision - Unit Tests")
+{
+    // Small fast circles that pass through each other within one step.
+    const auto spawnCircles = []()
+    {
+        return std::vector<Circle>{
+            Circle{glm::vec2{100.0f, 100.0f}, glm::vec2{MAX_VELOCITY, 0.0f}, MIN_RADIUS},
+            Circle{glm::vec2{110.0f, 100.0f}, glm::vec2{-MAX_VELOCITY, 0.0f}, MIN_RADIUS}};
+    };
+
+    SECTION("Time Of Impact")
+    {
+        const std::vector<Circle> circles{spawnCircles()};
+        float_t timeOfImpact{0.0f};
+        REQUIRE(TimeOfImpactCircleCircle(circles[0], circles[1], DELTA, timeOfImpact));
+        REQUIRE(glm::abs(timeOfImpact - 0.02f) < 0.0001f);
+        REQUIRE_FALSE(TimeOfImpactCircleCircle(circles[1], Circle{glm::vec2{500.0f, 500.0f}, glm::vec2{}, MIN_RADIUS}, DELTA, timeOfImpact));
+    }
+
+    SECTION("Find Leaves Along Segment")
+    {
+        std::vector<Circle> circles{spawnCircles()};
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+
+        std::vector<Circle*> foundLeaves{};
+        REQUIRE(quadtree.FindLeavesAlongSegment(glm::vec2{0.0f, 0.0f}, glm::vec2{200.0f, 200.0f}, MIN_RADIUS, foundLeaves));
+        REQUIRE(std::ranges::find(foundLeaves, &circles[0]) != std::end(foundLeaves));
+
+        foundLeaves.clear();
+        REQUIRE_FALSE(quadtree.FindLeavesAlongSegment(glm::vec2{0.0f, -50.0f}, glm::vec2{100.0f, -20.0f}, MIN_RADIUS, foundLeaves));
+    }
+
+    SECTION("Discrete Tunnels")
+    {
+        std::vector<Circle> circles{spawnCircles()};
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeFoundLeaves(circles, quadtree, DELTA);
+        REQUIRE(circles[0].m_Position.x > circles[1].m_Position.x);
+    }
+
+    SECTION("Swept Does Not Tunnel")
+    {
+        std::vector<Circle> circles{spawnCircles()};
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeSwept(circles, quadtree, DELTA);
+        REQUIRE(circles[0].m_Position.x < circles[1].m_Position.x);
+        REQUIRE(circles[0].m_Velocity.x < 0.0f);
+        REQUIRE(circles[1].m_Velocity.x > 0.0f);
+    }
+
+    SECTION("Swept Does Not Tunnel Faster Than Max Velocity")
+    {
+        // Collisions can leave a circle faster than MAX_VELOCITY, the slow circle updated first must still find it.
+        // The resting circles split the Quadtree so the fast circle starts in a Branch the slow circle's
+        // MAX_VELOCITY padded search would not reach.
+        std::vector<Circle> circles{
+            Circle{glm::vec2{100.0f, 100.0f}, glm::vec2{MIN_VELOCITY, 0.0f}, MIN_RADIUS},
+            Circle{glm::vec2{250.0f, 100.0f}, glm::vec2{-MAX_VELOCITY * 10.0f, 0.0f}, MIN_RADIUS},
+            Circle{glm::vec2{20.0f, 20.0f}, glm::vec2{}, MIN_RADIUS},
+            Circle{glm::vec2{40.0f, 20.0f}, glm::vec2{}, MIN_RADIUS},
+            Circle{glm::vec2{20.0f, 40.0f}, glm::vec2{}, MIN_RADIUS},
+            Circle{glm::vec2{40.0f, 40.0f}, glm::vec2{}, MIN_RADIUS}};
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeSwept(circles, quadtree, DELTA);
+        REQUIRE(circles[0].m_Position.x < circles[1].m_Position.x);
+        REQUIRE(circles[0].m_Velocity.x < 0.0f);
+        REQUIRE(circles[1].m_Velocity.x > 0.0f);
+    }
+
+    // Resting circles placed first, so every circle before the pair has already been updated when it is reached.
+    const auto spawnRestingCircles = []()
+    {
+        std::vector<Circle> circles{};
+        for(uint32_t i{0}; i != 50; ++i)
+        {
+            circles.push_back(Circle{glm::vec2{100.0f + i * 20.0f, 900.0f}, glm::vec2{}, MIN_RADIUS});
+        }
+        return circles;
+    };
+
+    SECTION("Swept Head On Collides Once")
+    {
+        std::vector<Circle> circles{spawnRestingCircles()};
+        circles.push_back(Circle{glm::vec2{500.0f, 500.0f}, glm::vec2{MAX_VELOCITY, 0.0f}, MIN_RADIUS});
+        circles.push_back(Circle{glm::vec2{520.0f, 500.0f}, glm::vec2{-MAX_VELOCITY, 0.0f}, MIN_RADIUS});
+        const size_t circleA{circles.size() - 2};
+        const size_t circleB{circles.size() - 1};
+
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeSwept(circles, quadtree, DELTA);
+
+        // Equal masses swap velocities, a second collision would swap them back.
+        REQUIRE(glm::abs(circles[circleA].m_Velocity.x + MAX_VELOCITY) < 0.001f);
+        REQUIRE(glm::abs(circles[circleB].m_Velocity.x - MAX_VELOCITY) < 0.001f);
+        REQUIRE(circles[circleA].m_Position.x < circles[circleB].m_Position.x);
+    }
+
+    SECTION("Swept Ignores Where Circles End Up")
+    {
+        // The paths cross but the circles pass each other, only comparing one circle's start with the other's end
+        // of frame position would report an impact.
+        std::vector<Circle> circles{spawnRestingCircles()};
+        circles.push_back(Circle{glm::vec2{500.0f, 500.0f}, glm::vec2{MAX_VELOCITY, 0.0f}, MIN_RADIUS});
+        circles.push_back(Circle{glm::vec2{530.0f, 490.0f}, glm::vec2{0.0f, MAX_VELOCITY}, MIN_RADIUS});
+        const size_t circleA{circles.size() - 2};
+        const size_t circleB{circles.size() - 1};
+
+        Quadtree quadtree{};
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeSwept(circles, quadtree, DELTA);
+
+        REQUIRE(circles[circleA].m_Velocity == glm::vec2{MAX_VELOCITY, 0.0f});
+        REQUIRE(circles[circleB].m_Velocity == glm::vec2{0.0f, MAX_VELOCITY});
+    }
+}
+
+TEST_CASE("Reorder Leaves - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    const std::vector<Circle> originalCircles{circles};
+    Quadtree quadtree{};
+    const std::vector<uint32_t> newIndices{ReorderLeaves(quadtree, circles)};
+
+    REQUIRE(newIndices.size() == originalCircles.size());
+    for(size_t i{0}; i != originalCircles.size(); ++i)
+    {
+        REQUIRE(circles[newIndices[i]].m_Position == originalCircles[i].m_Position);
+    }
+
+    // Every leaf Branch now points at a contiguous run of Leaves.
+    std::vector<const Quadtree::Branch*> branches{};
+    quadtree.FindBranches(quadtree.GetRootBranch().GetRect(), branches);
+    for(const Quadtree::Branch* const branch : branches)
+    {
+        const std::pmr::vector<Circle*>& leaves{branch->GetLeaves()};
+        if(!leaves.empty())
+        {
+            const auto [minLeaf, maxLeaf] {std::ranges::minmax(leaves)};
+            REQUIRE(static_cast<size_t>(maxLeaf - minLeaf) + 1 == leaves.size());
+        }
+    }
+}
+
+TEST_CASE("Reorder Leaves - Benchmarks")
+{
+    constexpr uint32_t numCircles{NUM_CIRCLES * 4};
+    std::vector<Circle> circles{};
+    circles.reserve(numCircles);
+    for(uint32_t i{0}; i != numCircles; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+
+    BENCHMARK("Inner Loop Spawn Order")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeInnerLoop(quadtree, quadtree.GetRootBranch(), 0.0f);
+    };
+
+    ReorderLeaves(quadtree, circles);
+
+    BENCHMARK("Inner Loop Reordered")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeInnerLoop(quadtree, quadtree.GetRootBranch(), 0.0f);
+    };
+
+    BENCHMARK("Reorder")
+    {
+        ReorderLeaves(quadtree, circles);
+    };
+}
+
+TEST_CASE("Raycast Quadtree - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+
+    SECTION("Front To Back")
+    {
+        float_t previousEntryDistance{0.0f};
+        bool isFrontToBack{true};
+        quadtree.Raycast(glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.5f}, 2000.0f, MAX_RADIUS, [&](Circle&, const float_t entryDistance)
+        {
+            isFrontToBack = isFrontToBack && entryDistance >= previousEntryDistance;
+            previousEntryDistance = entryDistance;
+            return true;
+        });
+        REQUIRE(isFrontToBack);
+    }
+
+    SECTION("Stop At First Visit")
+    {
+        uint32_t visits{0};
+        quadtree.Raycast(glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, 2000.0f, MAX_RADIUS, [&visits](Circle&, float_t)
+        {
+            ++visits;
+            return false;
+        });
+        REQUIRE(visits == 1);
+    }
+
+    SECTION("Closest Hit Matches Brute Force")
+    {
+        // An origin inside more than one circle hits them all at distance 0, keep the closest hit unique.
+        const auto isInsideCircle = [&circles](const glm::vec2& point)
+        {
+            return std::ranges::any_of(circles, [&point](const Circle& circle)
+            {
+                return glm::length(point - circle.m_Position) <= circle.m_Radius;
+            });
+        };
+
+        for(uint32_t i{0}; i != 1000; ++i)
+        {
+            glm::vec2 origin{RandomWindowPosition()};
+            while(isInsideCircle(origin))
+            {
+                origin = RandomWindowPosition();
+            }
+            const glm::vec2 direction{RandomNormal()};
+            constexpr float_t maxDistance{500.0f};
+
+            Circle* expectedCircle{nullptr};
+            float_t expectedDistance{maxDistance};
+            for(Circle& circle : circles)
+            {
+                float_t distance{0.0f};
+                if(IntersectRayCircle(origin, direction, expectedDistance, circle, distance))
+                {
+                    expectedCircle = &circle;
+                    expectedDistance = distance;
+                }
+            }
+
+            float_t hitDistance{0.0f};
+            const Circle* const hitCircle{RaycastCircles(quadtree, origin, direction, maxDistance, hitDistance)};
+            REQUIRE(hitCircle == expectedCircle);
+            REQUIRE(glm::abs(hitDistance - expectedDistance) < 0.01f);
+        }
+    }
+
+    SECTION("Circle Overlapping Ray From Uncrossed Branch")
+    {
+        // The root splits at y = 540, the ray only crosses the top Branches but the circle's centre is below.
+        std::vector<Circle> splitCircles{
+            SpawnCircle(glm::vec2{500.0f, 545.0f}),
+            SpawnCircle(glm::vec2{100.0f, 100.0f}),
+            SpawnCircle(glm::vec2{1800.0f, 100.0f}),
+            SpawnCircle(glm::vec2{100.0f, 1000.0f}),
+            SpawnCircle(glm::vec2{1800.0f, 1000.0f})};
+        splitCircles[0].m_Radius = MAX_RADIUS;
+        Quadtree splitQuadtree{};
+        RebuildQuadtree(splitQuadtree, splitCircles);
+        REQUIRE(splitQuadtree.GetRootBranch().HasBranches());
+
+        float_t hitDistance{0.0f};
+        REQUIRE(RaycastCircles(splitQuadtree, glm::vec2{0.0f, 539.0f}, glm::vec2{1.0f, 0.0f}, 1000.0f, hitDistance) == &splitCircles[0]);
+        REQUIRE(hitDistance < 500.0f);
+    }
+}
+
+TEST_CASE("Raycast Quadtree - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+
+    std::vector<std::pair<glm::vec2, glm::vec2>> rays{};
+    rays.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        rays.emplace_back(RandomWindowPosition(), RandomNormal());
+    }
+    constexpr float_t maxDistance{1000.0f};
+
+    BENCHMARK("Raycast")
+    {
+        uint32_t hits{0};
+        for(const auto& [origin, direction] : rays)
+        {
+            float_t hitDistance{0.0f};
+            hits += RaycastCircles(quadtree, origin, direction, maxDistance, hitDistance) ? 1 : 0;
+        }
+        return hits;
+    };
+
+    BENCHMARK("Bounding Rect")
+    {
+        uint32_t hits{0};
+        std::vector<Circle*> foundLeaves{};
+        for(const auto& [origin, direction] : rays)
+        {
+            foundLeaves.clear();
+            const glm::vec2 end{origin + direction * maxDistance};
+            const glm::vec2 topLeft{glm::min(origin, end)};
+            const glm::vec2 bottomRight{glm::max(origin, end)};
+            quadtree.FindLeaves(Rectangle{topLeft, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y}, foundLeaves);
+
+            float_t closestDistance{maxDistance};
+            bool hit{false};
+            for(const Circle* const circle : foundLeaves)
+            {
+                float_t distance{0.0f};
+                if(IntersectRayCircle(origin, direction, closestDistance, *circle, distance))
+                {
+                    closestDistance = distance;
+                    hit = true;
+                }
+            }
+            hits += hit ? 1 : 0;
+        }
+        return hits;
+    };
+}
+
+TEST_CASE("Gravity Quadtree - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+        circles.back().m_Velocity = {};
+    }
+
+    MassQuadtree quadtree{};
+    RebuildMassQuadtree(quadtree, circles);
+
+    SECTION("Root Aggregate")
+    {
+        float_t totalMass{0.0f};
+        for(const Circle& circle : circles)
+        {
+            totalMass += circle.m_Mass;
+        }
+
+        const CircleMassAggregate& aggregate{quadtree.GetRootBranch().GetAggregate()};
+        REQUIRE(aggregate.m_Count == NUM_CIRCLES);
+        REQUIRE(glm::abs(aggregate.m_Mass - totalMass) < totalMass * 0.0001f);
+    }
+
+    SECTION("Approximates Brute Force")
+    {
+        std::vector<Circle> expectedCircles{circles};
+        ApplyGravityBruteForce(expectedCircles, DELTA);
+        ApplyGravityQuadtree(circles, quadtree, 0.5f, DELTA);
+
+        float_t errorSum{0.0f};
+        float_t magnitudeSum{0.0f};
+        for(size_t i{0}; i != circles.size(); ++i)
+        {
+            errorSum += glm::length(circles[i].m_Velocity - expectedCircles[i].m_Velocity);
+            magnitudeSum += glm::length(expectedCircles[i].m_Velocity);
+        }
+        REQUIRE(errorSum < magnitudeSum * 0.05f);
+    }
+}
+
+TEST_CASE("Gravity - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    MassQuadtree quadtree{};
+
+    BENCHMARK("Quadtree")
+    {
+        RebuildMassQuadtree(quadtree, circles);
+        ApplyGravityQuadtree(circles, quadtree, 0.5f, DELTA);
+    };
+
+    BENCHMARK("Brute Force")
+    {
+        ApplyGravityBruteForce(circles, DELTA);
+    };
+}
+
+TEST_CASE("Sweep And Prune - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    const auto bruteForcePairs = [&circles]()
+    {
+        std::vector<std::pair<const Circle*, const Circle*>> pairs{};
+        for(const Circle& circle : circles)
+        {
+            for(const Circle& otherCircle : circles)
+            {
+                if(&circle < &otherCircle &&
+                    glm::abs(circle.m_Position.x - otherCircle.m_Position.x) <= circle.m_Radius + otherCircle.m_Radius &&
+                    glm::abs(circle.m_Position.y - otherCircle.m_Position.y) <= circle.m_Radius + otherCircle.m_Radius)
+                {
+                    pairs.emplace_back(&circle, &otherCircle);
+                }
+            }
+        }
+        std::ranges::sort(pairs);
+        return pairs;
+    };
+
+    const auto sweepAndPrunePairs = [&circles](const SweepAndPrune& sweepAndPrune)
+    {
+        std::vector<std::pair<const Circle*, const Circle*>> pairs{};
+        sweepAndPrune.VisitOverlappingPairs(circles, [&pairs](const Circle& circle, const Circle& otherCircle)
+        {
+            pairs.push_back(std::minmax(&circle, &otherCircle));
+        });
+        std::ranges::sort(pairs);
+        return pairs;
+    };
+
+    SweepAndPrune sweepAndPrune{};
+    sweepAndPrune.Update(circles);
+    REQUIRE(sweepAndPrunePairs(sweepAndPrune) == bruteForcePairs());
+
+    // Re-sorting after the circles move and more are spawned.
+    for(Circle& circle : circles)
+    {
+        circle.m_Position += circle.m_Velocity * DELTA;
+        ResolveCollisionCircleEdgeOfScreen(circle);
+    }
+    circles.push_back(SpawnCircle(RandomWindowPosition()));
+    sweepAndPrune.Update(circles);
+    REQUIRE(sweepAndPrunePairs(sweepAndPrune) == bruteForcePairs());
+
+    // Removing circles sorts from scratch.
+    circles.erase(std::begin(circles) + static_cast<std::ptrdiff_t>(circles.size() / 2), std::end(circles));
+    sweepAndPrune.Update(circles);
+    REQUIRE(sweepAndPrunePairs(sweepAndPrune) == bruteForcePairs());
+}
+
+TEST_CASE("Sweep And Prune - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    SweepAndPrune sweepAndPrune{};
+    Quadtree quadtree{};
+
+    BENCHMARK("Sweep And Prune")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        UpdateCirclesSweepAndPrune(circles, sweepAndPrune, DELTA);
+    };
+
+    BENCHMARK("Quadtree Inner Loop")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeInnerLoop(quadtree, quadtree.GetRootBranch(), DELTA);
+    };
+
+    // A circle spawned each update is merged in without re-sorting the rest.
+    std::vector<Circle> spawnCircles{circles};
+    SweepAndPrune spawnSweepAndPrune{};
+    spawnSweepAndPrune.Update(spawnCircles);
+    BENCHMARK("Sweep And Prune Spawn")
+    {
+        spawnCircles.push_back(SpawnCircle(RandomWindowPosition()));
+        spawnSweepAndPrune.Update(spawnCircles);
+    };
+
+    // Mostly horizontal motion keeps the sorted order coherent between frames.
+    for(Circle& circle : circles)
+    {
+        circle.m_Velocity.y *= 0.1f;
+    }
+
+    BENCHMARK("Sweep And Prune Horizontal")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        UpdateCirclesSweepAndPrune(circles, sweepAndPrune, DELTA);
+    };
+
+    BENCHMARK("Quadtree Inner Loop Horizontal")
+    {
+        for(Circle& circle : circles)
+        {
+            ResolveCollisionCircleEdgeOfScreen(circle);
+        }
+        RebuildQuadtree(quadtree, circles);
+        UpdateCirclesQuadtreeInnerLoop(quadtree, quadtree.GetRootBranch(), DELTA);
+    };
 }
 
 TEST_CASE("Brute Force - Benchmarks")
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/simulation.h"
+#include "simulation/quadtree.h"
+
+namespace
+{
+    inline constexpr uint32_t NUM_QUERY_THREADS{16};
+    inline constexpr uint32_t NUM_QUERIES_PER_THREAD{2000};
+
+    std::vector<Rectangle> RandomQueryRects(const uint32_t count)
+    {
+        std::vector<Rectangle> rects{};
+        rects.reserve(count);
+        for(uint32_t i{0}; i != count; ++i)
+        {
+            const float_t widthHeight{Random::RandomInRange(10.0f, 200.0f)};
+            rects.emplace_back(RandomWindowPosition(), widthHeight, widthHeight);
+        }
+        return rects;
+    }
+}
+
+TEST_CASE("Quadtree View - Unit Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    const QuadtreeView view{quadtree};
+
+    for(const Rectangle& rect : RandomQueryRects(100))
+    {
+        std::vector<Circle*> expectedLeaves{};
+        quadtree.FindLeaves(rect, expectedLeaves);
+        const std::span<const Circle* const> foundLeaves{view.FindLeaves(rect)};
+        REQUIRE(std::ranges::equal(foundLeaves, expectedLeaves));
+
+        std::vector<Quadtree::Branch*> expectedBranches{};
+        quadtree.FindBranches(rect, expectedBranches);
+        const std::span<const Quadtree::Branch* const> foundBranches{view.FindBranches(rect)};
+        REQUIRE(std::ranges::equal(foundBranches, expectedBranches));
+
+        REQUIRE(view.FindBranch(rect.GetTopLeft()) == quadtree.FindBranch(rect.GetTopLeft()));
+    }
+}
+
+// Run under ThreadSanitizer to verify concurrent queries are free of data races.
+TEST_CASE("Quadtree View - Concurrent Stress Tests")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    const QuadtreeView view{quadtree};
+
+    const std::vector<Rectangle> rects{RandomQueryRects(NUM_QUERIES_PER_THREAD)};
+    std::vector<size_t> expectedCounts{};
+    expectedCounts.reserve(rects.size());
+    for(const Rectangle& rect : rects)
+    {
+        expectedCounts.push_back(view.FindLeaves(rect).size());
+    }
+
+    std::atomic<uint32_t> mismatches{0};
+    {
+        std::vector<std::jthread> threads{};
+        threads.reserve(NUM_QUERY_THREADS);
+        for(uint32_t i{0}; i != NUM_QUERY_THREADS; ++i)
+        {
+            threads.emplace_back([&view, &rects, &expectedCounts, &mismatches, i]()
+            {
+                // Each thread walks the queries from a different starting point.
+                for(uint32_t j{0}; j != NUM_QUERIES_PER_THREAD; ++j)
+                {
+                    const uint32_t index{(i * 97 + j) % NUM_QUERIES_PER_THREAD};
+                    if(view.FindLeaves(rects[index]).size() != expectedCounts[index])
+                    {
+                        ++mismatches;
+                    }
+                    view.FindBranches(rects[index]);
+                    view.FindBranch(rects[index].GetTopLeft());
+                }
+            });
+        }
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Quadtree View - Benchmarks")
+{
+    std::vector<Circle> circles{};
+    circles.reserve(NUM_CIRCLES);
+    for(uint32_t i{0}; i != NUM_CIRCLES; ++i)
+    {
+        circles.push_back(SpawnCircle(RandomWindowPosition()));
+    }
+
+    Quadtree quadtree{};
+    RebuildQuadtree(quadtree, circles);
+    const QuadtreeView view{quadtree};
+    const std::vector<Rectangle> rects{RandomQueryRects(NUM_QUERIES_PER_THREAD)};
+
+    BENCHMARK("Single Thread")
+    {
+        size_t found{0};
+        for(uint32_t i{0}; i != NUM_QUERY_THREADS; ++i)
+        {
+            for(const Rectangle& rect : rects)
+            {
+                found += view.FindLeaves(rect).size();
+            }
+        }
+        return found;
+    };
+
+    BENCHMARK("Multiple Threads")
+    {
+        std::atomic<size_t> found{0};
+        {
+            std::vector<std::jthread> threads{};
+            threads.reserve(NUM_QUERY_THREADS);
+            for(uint32_t i{0}; i != NUM_QUERY_THREADS; ++i)
+            {
+                threads.emplace_back([&view, &rects, &found]()
+                {
+                    size_t threadFound{0};
+                    for(const Rectangle& rect : rects)
+                    {
+                        threadFound += view.FindLeaves(rect).size();
+                    }
+                    found += threadFound;
+                });
+            }
+        }
+        return found.load();
+    };
+}
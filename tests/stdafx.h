@@ -4,3 +4,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
+
+inline constexpr uint32_t NUM_CIRCLES{5000};
+inline constexpr float_t DELTA{0.1f};
+inline constexpr size_t FRAME_ARENA_SIZE{4 * 1024 * 1024};
@@ -11,12 +11,19 @@
 
 #include "quadtree.h"
 #include "sdlextensions.h"
+#include <array>
 #include <string>
 #include <format>
+#include <memory_resource>
 
 struct AppData
 {
-    Quadtree m_Quadtree{};
+    // Backs this frame's Quadtree and query results, released in one go at the start of the next frame. The
+    // arena is given its own buffer so releasing it only rewinds, it falls back to the heap if a frame outgrows it.
+    std::array<std::byte, FRAME_ARENA_SIZE> m_FrameArenaBuffer{};
+    std::pmr::monotonic_buffer_resource m_FrameArena{m_FrameArenaBuffer.data(), m_FrameArenaBuffer.size()};
+    Quadtree m_Quadtree{&m_FrameArena};
+    DoubleBufferedQuadtree m_DoubleBufferedQuadtree{};
     std::vector<Circle> m_Circles{};
     SDL_Renderer* m_Renderer{nullptr};
     SDL_Window* m_Window{nullptr};
@@ -25,6 +32,13 @@ struct AppData
     bool m_DrawQuadtree{true};
     bool m_DrawTestSelectionQuad{true};
     bool m_UseQuadTree{true};
+    bool m_UseDoubleBufferedQuadtree{false};
+    uint32_t m_FramesSinceReorder{0};
+    // Render buffers, reused every frame so drawing does not allocate.
+    std::vector<Circle*> m_VisibleCircles{};
+    std::vector<SDL_Vertex> m_CircleVertices{};
+    std::vector<int> m_CircleIndices{};
+    std::vector<SDL_FRect> m_Rects{};
 };
 
 SDL_AppResult SDL_AppInit(
@@ -80,6 +94,8 @@ SDL_AppResult SDL_AppEvent(void* const appState, SDL_Event* const event)
             appData->m_DrawQuadtree = !appData->m_DrawQuadtree;
         else if(event->key.key == SDLK_2)
             appData->m_DrawTestSelectionQuad = !appData->m_DrawTestSelectionQuad;
+        else if(event->key.key == SDLK_3)
+            appData->m_UseDoubleBufferedQuadtree = !appData->m_UseDoubleBufferedQuadtree;
         else if(event->key.key == SDLK_RETURN)
             appData->m_UseQuadTree = !appData->m_UseQuadTree;
 
@@ -96,24 +112,49 @@ SDL_AppResult SDL_AppIterate(void* const appState)
     AppData* const appData{reinterpret_cast<AppData*>(appState)};
     const float_t delta{SDL_FrameDelta()};
 
-    // Log fps
+    // Log fps, simulation and render times are averaged over the same second.
     static float_t deltaSum{0.0f};
     static uint32_t frames{0};
     static uint32_t fps{0};
+    static float_t simulationMillisecondsSum{0.0f};
+    static float_t renderMillisecondsSum{0.0f};
+    static float_t simulationMilliseconds{0.0f};
+    static float_t renderMilliseconds{0.0f};
     if(deltaSum > 1.0f)
     {
         SDL_Log("FPS - %i", frames);
         fps = frames;
+        simulationMilliseconds = simulationMillisecondsSum / static_cast<float_t>(frames);
+        renderMilliseconds = renderMillisecondsSum / static_cast<float_t>(frames);
         deltaSum = 0.0f;
         frames = 0;
+        simulationMillisecondsSum = 0.0f;
+        renderMillisecondsSum = 0.0f;
     }
     deltaSum += delta;
     ++frames;
 
-    SDL_SetRenderDrawColor(appData->m_Renderer, 0, 0, 0, 255);
-    SDL_RenderClear(appData->m_Renderer);
+    const uint64_t simulationStart{SDL_GetPerformanceCounter()};
 
-    RebuildQuadtree(appData->m_Quadtree, appData->m_Circles);
+    // The previous frame's background rebuild becomes the Quadtree read by rendering this frame.
+    if(appData->m_UseDoubleBufferedQuadtree)
+    {
+        appData->m_DoubleBufferedQuadtree.Swap();
+    }
+
+    appData->m_Quadtree.Reset();
+    appData->m_FrameArena.release();
+
+    // Periodically keep circles that are close in space close in memory, reordering rebuilds the Quadtree.
+    if(++appData->m_FramesSinceReorder == REORDER_CIRCLES_FRAME_INTERVAL)
+    {
+        ReorderLeaves(appData->m_Quadtree, appData->m_Circles);
+        appData->m_FramesSinceReorder = 0;
+    }
+    else
+    {
+        RebuildQuadtree(appData->m_Quadtree, appData->m_Circles);
+    }
 
     if(!appData->m_Paused)
     {
@@ -127,20 +168,51 @@ SDL_AppResult SDL_AppIterate(void* const appState)
         }
     }
 
-    // Draw and clamp within screen.
+    // Clamp within screen.
     for(Circle& circle : appData->m_Circles)
     {
         ResolveCollisionCircleEdgeOfScreen(circle);
-        SDL_SetRenderDrawColor(
-            appData->m_Renderer,
-            static_cast<uint8_t>(glm::clamp(255.0f * (glm::length(circle.m_Velocity) / MAX_VELOCITY), 50.f, 255.0f)), 0, 0, 255);
-        SDL_RenderFillCircle(appData->m_Renderer, circle.m_Position.x, circle.m_Position.y, circle.m_Radius);
     }
 
+    // Build next frame's Quadtree in the background while this frame's read only queries run.
+    if(appData->m_UseDoubleBufferedQuadtree)
+    {
+        appData->m_DoubleBufferedQuadtree.BeginRebuild(appData->m_Circles);
+    }
+
+    simulationMillisecondsSum += SDL_MillisecondsSince(simulationStart);
+    const uint64_t renderStart{SDL_GetPerformanceCounter()};
+
+    SDL_SetRenderDrawColor(appData->m_Renderer, 0, 0, 0, 255);
+    SDL_RenderClear(appData->m_Renderer);
+
+    // Circles are stored by their centre, so pad the view to keep circles overlapping its edges.
+    const Rectangle view{
+        glm::vec2{-MAX_RADIUS, -MAX_RADIUS},
+        static_cast<float_t>(WINDOW_WIDTH) + MAX_RADIUS * 2.0f,
+        static_cast<float_t>(WINDOW_HEIGHT) + MAX_RADIUS * 2.0f};
+
+    // Draw every circle in view with a single call, culled by this frame's Quadtree which points at m_Circles.
+    appData->m_VisibleCircles.clear();
+    appData->m_CircleVertices.clear();
+    appData->m_CircleIndices.clear();
+    appData->m_Quadtree.FindLeaves(view, appData->m_VisibleCircles);
+    for(const Circle* const circle : appData->m_VisibleCircles)
+    {
+        const float_t red{glm::clamp(glm::length(circle->m_Velocity) / MAX_VELOCITY, 50.0f / 255.0f, 1.0f)};
+        SDL_AppendFillCircle(
+            appData->m_CircleVertices, appData->m_CircleIndices,
+            circle->m_Position.x, circle->m_Position.y, circle->m_Radius, SDL_FColor{red, 0.0f, 0.0f, 1.0f});
+    }
+    SDL_RenderGeometryBatch(appData->m_Renderer, appData->m_CircleVertices, appData->m_CircleIndices);
+
+    const Quadtree& readQuadtree{
+        appData->m_UseDoubleBufferedQuadtree ? appData->m_DoubleBufferedQuadtree.GetQuadtree() : appData->m_Quadtree};
+
     if(appData->m_DrawQuadtree)
     {
         SDL_SetRenderDrawColor(appData->m_Renderer, 0, 0, 255, 255);
-        RenderQuadtree(appData->m_Renderer, appData->m_Quadtree.GetRootBranch());
+        RenderQuadtree(appData->m_Renderer, readQuadtree, view, appData->m_Rects);
     }
 
     if(appData->m_DrawTestSelectionQuad)
@@ -148,49 +220,53 @@ SDL_AppResult SDL_AppIterate(void* const appState)
         constexpr float_t width{75.0f};
         constexpr float_t height{75.0f};
         const Rectangle mouseRect{appData->m_MousePoint - glm::vec2{width * 0.5f, height * 0.5f}, width, height};
-        const SDL_FRect rect{mouseRect.GetTopLeft().x, mouseRect.GetTopLeft().y, mouseRect.GetWidth(), mouseRect.GetHeight()};
-        SDL_SetRenderDrawColor(appData->m_Renderer, 255, 255, 255, 255);
-        SDL_RenderRect(appData->m_Renderer, &rect);
 
-        std::vector<Quadtree::Branch*> branches{};
-        if(appData->m_Quadtree.FindBranches(mouseRect, branches))
+        appData->m_Rects.clear();
+        appData->m_Rects.push_back(SDL_FRect{mouseRect.GetTopLeft().x, mouseRect.GetTopLeft().y, mouseRect.GetWidth(), mouseRect.GetHeight()});
+        std::pmr::vector<const Quadtree::Branch*> branches{&appData->m_FrameArena};
+        readQuadtree.FindBranches(mouseRect, branches);
+        for(const Quadtree::Branch* const branch : branches)
         {
-            for(const Quadtree::Branch* const branch : branches)
-            {
-                const SDL_FRect branchRect{
-                    branch->GetRect().GetTopLeft().x,
-                    branch->GetRect().GetTopLeft().y,
-                    branch->GetRect().GetWidth(),
-                    branch->GetRect().GetHeight()};
-                SDL_RenderRect(appData->m_Renderer, &branchRect);
-            }
+            const Rectangle& branchRect{branch->GetRect()};
+            appData->m_Rects.push_back(SDL_FRect{branchRect.GetTopLeft().x, branchRect.GetTopLeft().y, branchRect.GetWidth(), branchRect.GetHeight()});
         }
+        SDL_SetRenderDrawColor(appData->m_Renderer, 255, 255, 255, 255);
+        SDL_RenderRects(appData->m_Renderer, appData->m_Rects.data(), static_cast<int>(appData->m_Rects.size()));
 
-        std::vector<Circle*> circles{};
-        if(appData->m_Quadtree.FindLeaves(mouseRect, circles))
+        appData->m_CircleVertices.clear();
+        appData->m_CircleIndices.clear();
+        std::pmr::vector<Circle*> circles{&appData->m_FrameArena};
+        readQuadtree.FindLeaves(mouseRect, circles);
+        for(const Circle* const circle : circles)
         {
-            for(const Circle* const circle : circles)
-            {
-                SDL_RenderFillCircle(appData->m_Renderer, circle->m_Position.x, circle->m_Position.y, circle->m_Radius);
-            }
+            SDL_AppendFillCircle(
+                appData->m_CircleVertices, appData->m_CircleIndices,
+                circle->m_Position.x, circle->m_Position.y, circle->m_Radius, SDL_FColor{1.0f, 1.0f, 1.0f, 1.0f});
         }
+        SDL_RenderGeometryBatch(appData->m_Renderer, appData->m_CircleVertices, appData->m_CircleIndices);
     }
 
     // Controls
     SDL_SetRenderDrawColor(appData->m_Renderer, 255, 255, 255, 255);
     SDL_SetRenderScale(appData->m_Renderer, 1.5f, 1.5f);
     SDL_RenderDebugText(appData->m_Renderer, 3.0f, 3.0f, std::format("FPS - {}", std::to_string(fps)).c_str());
-    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 13.0f, "[1] - Render Quadtree on/off");
-    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 23.0f, "[2] - Render mouse position Quadtree test on/off");
-    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 33.0f, "[Space] - Pause on/off");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 13.0f,
+        std::format("Simulation - {:.2f}ms Render - {:.2f}ms", simulationMilliseconds, renderMilliseconds).c_str());
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 23.0f, "[1] - Render Quadtree on/off");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 33.0f, "[2] - Render mouse position Quadtree test on/off");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 43.0f, "[3] - Render from double buffered Quadtree on/off");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 53.0f, "[Space] - Pause on/off");
     if(appData->m_UseQuadTree)
-        SDL_RenderDebugText(appData->m_Renderer, 3.0f, 43.0f, "[Enter] - Use brute force collision testing");
+        SDL_RenderDebugText(appData->m_Renderer, 3.0f, 63.0f, "[Enter] - Use brute force collision testing");
     else
-        SDL_RenderDebugText(appData->m_Renderer, 3.0f, 43.0f, "[Enter] - Use Quadtree collision testing");
-    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 53.0f, "[Left Click] - Spawn circle at mouse pointer");
-    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 63.0f, "[ESC] - Shutdown");
+        SDL_RenderDebugText(appData->m_Renderer, 3.0f, 63.0f, "[Enter] - Use Quadtree collision testing");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 73.0f, "[Left Click] - Spawn circle at mouse pointer");
+    SDL_RenderDebugText(appData->m_Renderer, 3.0f, 83.0f, "[ESC] - Shutdown");
     SDL_SetRenderScale(appData->m_Renderer, 1.0f, 1.0f);
 
+    // Measured before present, which can block waiting for vsync.
+    renderMillisecondsSum += SDL_MillisecondsSince(renderStart);
+
     SDL_RenderPresent(appData->m_Renderer);
 
     return SDL_APP_CONTINUE;
@@ -1,23 +1,37 @@
 #pragma once
 
+#include <vector>
+
 #include <SDL3/SDL_render.h>
 
 #include "simulation/quadtreeconcept.h"
 
+// Appends the Rectangle of every leaf Branch overlapping view, Branches outside the view are skipped whole.
 template<class TQuadtree>
-void RenderQuadtreeConcept(SDL_Renderer* const renderer, const typename TQuadtree::Branch& branch)
+void AppendQuadtreeRectsConcept(const typename TQuadtree::Branch& branch, const Rectangle& view, std::vector<SDL_FRect>& rects)
 {
+    const Rectangle& rectangle{branch.GetRect()};
+    if(!CollisionRectRect(view, rectangle))
+        return;
+
     if(!branch.HasBranches())
     {
-        const Rectangle& rectangle{branch.GetRect()};
-        const SDL_FRect rect{rectangle.GetTopLeft().x, rectangle.GetTopLeft().y, rectangle.GetWidth(), rectangle.GetHeight()};
-        SDL_RenderRect(renderer, &rect);
+        rects.push_back(SDL_FRect{rectangle.GetTopLeft().x, rectangle.GetTopLeft().y, rectangle.GetWidth(), rectangle.GetHeight()});
     }
 
-    for(const TQuadtree::Branch& childBranch : branch.GetBranches())
+    for(const typename TQuadtree::Branch& childBranch : branch.GetBranches())
     {
-        RenderQuadtreeConcept<TQuadtree>(renderer, childBranch);
+        AppendQuadtreeRectsConcept<TQuadtree>(childBranch, view, rects);
     }
 }
 
+// Draws every leaf Branch in view with a single SDL_RenderRects call, rects is reused between frames.
+template<class TQuadtree>
+void RenderQuadtreeConcept(SDL_Renderer* const renderer, const TQuadtree& quadtree, const Rectangle& view, std::vector<SDL_FRect>& rects)
+{
+    rects.clear();
+    AppendQuadtreeRectsConcept<TQuadtree>(quadtree.GetRootBranch(), view, rects);
+    SDL_RenderRects(renderer, rects.data(), static_cast<int>(rects.size()));
+}
+
 inline constexpr auto RenderQuadtree = RenderQuadtreeConcept<Quadtree>;
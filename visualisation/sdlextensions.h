@@ -1,9 +1,16 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
+#include <glm/gtc/constants.hpp>
+#include <SDL3/SDL_render.h>
 #include <SDL3/SDL_timer.h>
 
 namespace
 {
+    inline constexpr uint32_t FILL_CIRCLE_SEGMENTS{16};
+
     // This is based on code taken from:
     // https://gist.github.com/wldomiciano/b38a28e2cde2c77b08ad824e7d8c0076#file-circle-drawing-c
 
@@ -63,6 +70,44 @@ namespace
 inline constexpr auto SDL_RenderCircle = SDL_RenderCircleConcept<SDL_RenderCircleStrategy>;
 inline constexpr auto SDL_RenderFillCircle = SDL_RenderCircleConcept<SDL_RenderFillCircleStrategy>;
 
+// Appends a filled circle as a triangle fan, so any number of circles can be drawn with one SDL_RenderGeometry call.
+inline void SDL_AppendFillCircle(
+    std::vector<SDL_Vertex>& vertices, std::vector<int>& indices, const float_t xc, const float_t yc, const float_t radius, const SDL_FColor& color)
+{
+    static const std::array<glm::vec2, FILL_CIRCLE_SEGMENTS> unitCircle{[]()
+    {
+        std::array<glm::vec2, FILL_CIRCLE_SEGMENTS> points{};
+        for(uint32_t i{0}; i != FILL_CIRCLE_SEGMENTS; ++i)
+        {
+            const float_t angle{glm::two_pi<float_t>() * static_cast<float_t>(i) / static_cast<float_t>(FILL_CIRCLE_SEGMENTS)};
+            points[i] = glm::vec2{glm::cos(angle), glm::sin(angle)};
+        }
+        return points;
+    }()};
+
+    const int centre{static_cast<int>(vertices.size())};
+    vertices.push_back(SDL_Vertex{SDL_FPoint{xc, yc}, color, SDL_FPoint{0.0f, 0.0f}});
+    for(uint32_t i{0}; i != FILL_CIRCLE_SEGMENTS; ++i)
+    {
+        vertices.push_back(SDL_Vertex{SDL_FPoint{xc + unitCircle[i].x * radius, yc + unitCircle[i].y * radius}, color, SDL_FPoint{0.0f, 0.0f}});
+        indices.push_back(centre);
+        indices.push_back(centre + 1 + static_cast<int>(i));
+        indices.push_back(centre + 1 + static_cast<int>((i + 1) % FILL_CIRCLE_SEGMENTS));
+    }
+}
+
+inline bool SDL_RenderGeometryBatch(SDL_Renderer* const renderer, const std::vector<SDL_Vertex>& vertices, const std::vector<int>& indices)
+{
+    return SDL_RenderGeometry(
+        renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+}
+
+inline float_t SDL_MillisecondsSince(const uint64_t performanceCounter)
+{
+    static const float_t performanceFrequency{static_cast<float_t>(SDL_GetPerformanceFrequency())};
+    return static_cast<float_t>(SDL_GetPerformanceCounter() - performanceCounter) * 1000.0f / performanceFrequency;
+}
+
 inline float_t SDL_FrameDelta()
 {
     static const float_t performanceFrequency{static_cast<float_t>(SDL_GetPerformanceFrequency())};
@@ -6,3 +6,5 @@
 #include <glm/gtx/norm.hpp>
 
 inline constexpr uint32_t NUM_CIRCLES{3000};
+inline constexpr uint32_t REORDER_CIRCLES_FRAME_INTERVAL{60};
+inline constexpr size_t FRAME_ARENA_SIZE{4 * 1024 * 1024};